@@ -0,0 +1,478 @@
+#include <iostream>
+#include <chrono>
+#include <list>
+#include <random>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+#include "include/factor.h"
+#include "include/bitvector.h"
+#include "include/arena.h"
+#include "include/aig.h"
+
+using namespace factor;
+
+////////////////////////////////////////////
+/////////// PERFORMANCE COUNTERS ///////////
+////////////////////////////////////////////
+#pragma region PERFORMANCE COUNTERS
+
+/// Hardware counters of the calling thread, read
+///     through perf_event_open. The counters are
+///     opened as one group behind a leader, so that
+///     they are scheduled onto the PMU together and
+///     count over the same intervals; if the kernel
+///     multiplexes the group, the counts are scaled
+///     by the time enabled over the time running.
+///     Each counter the kernel refuses, e.g. inside
+///     a container, is silently left out of the
+///     report, which then degrades to the wall time
+///     alone, as it also does if the group never ran.
+class counters
+{
+    struct counter
+    {
+        const char* m_name;
+        uint32_t m_type;
+        uint64_t m_config;
+        int m_file_descriptor;
+        uint64_t m_value;
+    };
+
+    std::vector<counter> m_counters;
+
+    /// The first counter opened, through which the
+    ///     whole group is enabled and read.
+    int m_leader = -1;
+
+    uint64_t m_time_enabled = 0;
+    uint64_t m_time_running = 0;
+
+    /// The configuration of a read miss counter
+    ///     of the argued cache.
+    static uint64_t read_misses(
+        uint64_t a_cache
+    )
+    {
+        return
+            a_cache |
+            (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+            (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    }
+
+public:
+
+    counters(
+
+    )
+    {
+        m_counters = {
+            { "cycles",        PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES,                 -1, 0 },
+            { "instructions",  PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS,               -1, 0 },
+            { "L1d misses",    PERF_TYPE_HW_CACHE, read_misses(PERF_COUNT_HW_CACHE_L1D),     -1, 0 },
+            { "LLC misses",    PERF_TYPE_HW_CACHE, read_misses(PERF_COUNT_HW_CACHE_LL),      -1, 0 },
+            { "branch misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES,              -1, 0 },
+            { "dTLB misses",   PERF_TYPE_HW_CACHE, read_misses(PERF_COUNT_HW_CACHE_DTLB),    -1, 0 },
+        };
+
+        for (counter& l_counter : m_counters)
+        {
+            perf_event_attr l_attributes = {};
+
+            l_attributes.size = sizeof(perf_event_attr);
+            l_attributes.type = l_counter.m_type;
+            l_attributes.config = l_counter.m_config;
+            l_attributes.exclude_kernel = 1;
+            l_attributes.exclude_hv = 1;
+            l_attributes.read_format =
+                PERF_FORMAT_GROUP |
+                PERF_FORMAT_TOTAL_TIME_ENABLED |
+                PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+            /// The members follow their leader, which
+            ///     alone starts out disabled.
+            l_attributes.disabled = m_leader < 0;
+
+            l_counter.m_file_descriptor = syscall(SYS_perf_event_open, &l_attributes, 0, -1, m_leader, 0);
+
+            if (m_leader < 0)
+                m_leader = l_counter.m_file_descriptor;
+
+        }
+
+    }
+
+    counters(
+        const counters&
+    ) = delete;
+
+    counters& operator=(
+        const counters&
+    ) = delete;
+
+    ~counters(
+
+    )
+    {
+        for (const counter& l_counter : m_counters)
+            if (l_counter.m_file_descriptor >= 0)
+                close(l_counter.m_file_descriptor);
+    }
+
+    void start(
+
+    )
+    {
+        if (m_leader < 0)
+            return;
+
+        ioctl(m_leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(m_leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+
+    }
+
+    void stop(
+
+    )
+    {
+        if (m_leader < 0)
+            return;
+
+        ioctl(m_leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+        /// The group reads as its size, the times
+        ///     enabled and running, then the value of
+        ///     each member in the order opened.
+        std::vector<uint64_t> l_values(3 + m_counters.size(), 0);
+
+        ssize_t l_read = read(m_leader, l_values.data(), l_values.size() * sizeof(uint64_t));
+
+        m_time_enabled = l_values[1];
+        m_time_running = l_read >= (ssize_t)(3 * sizeof(uint64_t)) ? l_values[2] : 0;
+
+        size_t l_member = 3;
+
+        for (counter& l_counter : m_counters)
+            if (l_counter.m_file_descriptor >= 0)
+                l_counter.m_value = m_time_running == 0 ? 0 :
+                    (uint64_t)((double)l_values[l_member++] * m_time_enabled / m_time_running);
+
+    }
+
+    /// Appends each available counter to a report line.
+    friend std::ostream& operator<<(
+        std::ostream& a_ostream,
+        const counters& a_counters
+    )
+    {
+        if (a_counters.m_time_running == 0)
+            return a_ostream;
+
+        for (const counter& l_counter : a_counters.m_counters)
+            if (l_counter.m_file_descriptor >= 0)
+                a_ostream << ", " << l_counter.m_value << " " << l_counter.m_name;
+
+        return a_ostream;
+
+    }
+
+};
+
+#pragma endregion
+
+////////////////////////////////////////////
+//////////////// BENCHMARKS ////////////////
+////////////////////////////////////////////
+#pragma region BENCHMARKS
+
+/// Runs one phase of a benchmark in a fresh dag,
+///     reporting its wall time, node count and
+///     any available hardware counters.
+template<typename FUNCTION>
+void phase(
+    const std::string& a_name,
+    const FUNCTION& a_function
+)
+{
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    counters l_counters;
+
+    auto l_start = std::chrono::steady_clock::now();
+
+    l_counters.start();
+
+    a_function();
+
+    l_counters.stop();
+
+    auto l_stop = std::chrono::steady_clock::now();
+
+    std::cout
+        << a_name << ": "
+        << std::chrono::duration<double, std::milli>(l_stop - l_start).count() << " ms, "
+        << l_nodes.size() << " nodes"
+        << l_counters
+        << std::endl;
+
+    global_node_sink::bind(nullptr);
+
+}
+
+/// Multiplies two words of variables. Beyond a
+///     few bits, the middle product bits have
+///     exponentially large DAGs in any order.
+template<size_t WIDTH>
+void bench_variable_multiply(
+
+)
+{
+    std::string l_suffix = std::to_string(WIDTH) + "x" + std::to_string(WIDTH);
+
+    phase("logic::multiply (variable) " + l_suffix, []
+    {
+        std::list<const node*> l_x;
+        std::list<const node*> l_y;
+
+        for (uint32_t i = 0; i < WIDTH; i++)
+        {
+            l_x.push_back(literal(i, true));
+            l_y.push_back(literal(i + WIDTH, true));
+        }
+
+        logic::multiply(l_x, l_y);
+
+    });
+
+    phase("factor::product (variable) " + l_suffix, []
+    {
+        operation_cache l_cache;
+        product(l_cache, bitvector<WIDTH>::variables(0), bitvector<WIDTH>::variables(WIDTH));
+    });
+
+}
+
+/// Multiplies a word of variables by a constant.
+template<size_t WIDTH>
+void bench_constant_multiply(
+    uint64_t a_constant
+)
+{
+    std::string l_suffix = std::to_string(WIDTH) + "x" + std::to_string(WIDTH);
+
+    phase("logic::multiply (constant) " + l_suffix, [a_constant]
+    {
+        std::list<const node*> l_x;
+        std::list<const node*> l_y;
+
+        for (uint32_t i = 0; i < WIDTH; i++)
+        {
+            l_x.push_back(literal(i, true));
+            l_y.push_back((a_constant >> i) & 0x1 ? ONE : ZERO);
+        }
+
+        logic::multiply(l_x, l_y);
+
+    });
+
+    phase("factor::product (constant) " + l_suffix, [a_constant]
+    {
+        operation_cache l_cache;
+        product(l_cache, bitvector<WIDTH>::variables(0), bitvector<WIDTH>::constant(a_constant));
+    });
+
+}
+
+/// Joins two middle bits of a variable product,
+///     timing only the join under each engine, so
+///     that the operands are equally cold for both.
+template<size_t WIDTH>
+void bench_join(
+
+)
+{
+    std::string l_suffix = std::to_string(WIDTH) + "x" + std::to_string(WIDTH);
+
+    for (join_engine l_engine : { join_engine::DEPTH_FIRST, join_engine::BREADTH_FIRST })
+    {
+        dag l_nodes;
+
+        global_node_sink::bind(&l_nodes);
+
+        operation_cache l_cache;
+
+        bitvector<2 * WIDTH> l_product =
+            product(l_cache, bitvector<WIDTH>::variables(0), bitvector<WIDTH>::variables(WIDTH));
+
+        size_t l_operand_nodes = l_nodes.size();
+
+        global_join_engine::bind(l_engine);
+
+        counters l_counters;
+
+        auto l_start = std::chrono::steady_clock::now();
+
+        l_counters.start();
+
+        const node* l_result = logic::disjoin(l_product[WIDTH - 1], logic::invert(l_product[WIDTH]));
+
+        l_counters.stop();
+
+        auto l_stop = std::chrono::steady_clock::now();
+
+        double l_milliseconds = std::chrono::duration<double, std::milli>(l_stop - l_start).count();
+
+        std::cout
+            << (l_engine == join_engine::DEPTH_FIRST ? "join (depth-first) " : "join (breadth-first) ")
+            << l_suffix << ": "
+            << l_milliseconds << " ms, "
+            << l_operand_nodes << " operand nodes, "
+            << node_count(l_result) << " result nodes, "
+            << (l_nodes.size() - l_operand_nodes) / l_milliseconds * 1000.0 << " nodes/s"
+            << l_counters
+            << std::endl;
+
+        global_join_engine::bind(join_engine::DEPTH_FIRST);
+        global_node_sink::bind(nullptr);
+
+    }
+
+}
+
+/// Builds a variable product with the nodes and
+///     cache in the default heap, and then in a huge
+///     page arena, timing the build and a traversal
+///     which evaluates every product bit on random
+///     inputs, where TLB misses dominate.
+template<size_t WIDTH>
+void bench_huge_pages(
+    size_t a_evaluations
+)
+{
+    std::string l_suffix = std::to_string(WIDTH) + "x" + std::to_string(WIDTH);
+
+    huge_page_arena l_arena;
+
+    for (std::pmr::memory_resource* l_resource : { std::pmr::get_default_resource(), (std::pmr::memory_resource*)&l_arena })
+    {
+        dag l_nodes(l_resource);
+
+        global_node_sink::bind(&l_nodes);
+
+        auto l_start = std::chrono::steady_clock::now();
+
+        bitvector<2 * WIDTH> l_product;
+
+        {
+            operation_cache l_cache(l_resource);
+            l_product = product(l_cache, bitvector<WIDTH>::variables(0), bitvector<WIDTH>::variables(WIDTH));
+        }
+
+        auto l_built = std::chrono::steady_clock::now();
+
+        /// Only the traversal is counted.
+        counters l_counters;
+
+        l_counters.start();
+
+        std::mt19937_64 l_random(0);
+
+        std::vector<bool> l_input(2 * WIDTH);
+
+        size_t l_ones = 0;
+
+        for (size_t i = 0; i < a_evaluations; i++)
+        {
+            uint64_t l_word = l_random();
+
+            for (size_t j = 0; j < 2 * WIDTH; j++)
+                l_input[j] = (l_word >> j) & 0x1;
+
+            for (size_t j = 0; j < 2 * WIDTH; j++)
+                l_ones += evaluate(l_product[j], l_input);
+
+        }
+
+        l_counters.stop();
+
+        auto l_stop = std::chrono::steady_clock::now();
+
+        std::cout
+            << (l_resource == &l_arena ? "huge page arena " : "default heap ")
+            << l_suffix << ": build "
+            << std::chrono::duration<double, std::milli>(l_built - l_start).count() << " ms, evaluate "
+            << std::chrono::duration<double, std::milli>(l_stop - l_built).count() << " ms, "
+            << l_nodes.size() << " nodes, "
+            << l_ones << " ones"
+            << l_counters
+            << std::endl;
+
+        global_node_sink::bind(nullptr);
+
+    }
+
+    std::cout
+        << "huge page arena: " << (l_arena.bytes() >> 20) << " MiB mapped, "
+        << l_arena.explicit_mappings() << " explicit huge page mappings"
+        << std::endl;
+
+}
+
+/// Multiplies two words of variables as an AIG,
+///     then materializes either the low half of the
+///     product, or all of it, against eager joining
+///     in bench_variable_multiply.
+template<size_t WIDTH>
+void bench_aig_multiply(
+
+)
+{
+    std::string l_suffix = std::to_string(WIDTH) + "x" + std::to_string(WIDTH);
+
+    for (size_t l_bits : { WIDTH, 2 * WIDTH })
+    {
+        phase("aig::materializer " + std::to_string(l_bits) + " bits " + l_suffix, [l_bits]
+        {
+            aig::graph l_graph;
+
+            aig::global_graph_sink::bind(&l_graph);
+
+            std::list<aig::signal> l_x;
+            std::list<aig::signal> l_y;
+
+            for (size_t i = 0; i < 2 * WIDTH; i++)
+                (i < WIDTH ? l_x : l_y).push_back({ l_graph.input() });
+
+            std::list<aig::signal> l_product = logic::multiply(l_x, l_y);
+
+            aig::materializer l_materializer(l_graph);
+
+            auto l_it = l_product.begin();
+
+            for (size_t i = 0; i < l_bits; i++)
+                l_materializer.materialize((l_it++)->m_edge);
+
+            aig::global_graph_sink::bind(nullptr);
+
+        });
+    }
+
+}
+
+#pragma endregion
+
+int main(
+
+)
+{
+    bench_variable_multiply<8>();
+    bench_aig_multiply<8>();
+    bench_constant_multiply<8>(0xb5);
+    bench_constant_multiply<12>(0xb35);
+    bench_join<10>();
+    bench_huge_pages<10>(250000);
+}
@@ -0,0 +1,305 @@
+#include <filesystem>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "include/checkpoint.h"
+
+namespace factor
+{
+
+    static constexpr char MAGIC[4] = { 'F', 'C', 'T', 'C' };
+    static constexpr uint32_t VERSION = 2;
+
+    /// Each record begins with one of these tags.
+    ///     A node holds its depth, its chain and the
+    ///     identifiers of its children, a root its
+    ///     name and the identifier of its node, and a
+    ///     commit the number of commits so far.
+    enum class tag : uint8_t
+    {
+        NODE = 'N',
+        ROOT = 'R',
+        COMMIT = 'C',
+    };
+
+    template<typename T>
+    static void write_value(
+        std::ostream& a_ostream,
+        const T& a_value
+    )
+    {
+        a_ostream.write(reinterpret_cast<const char*>(&a_value), sizeof(T));
+    }
+
+    /// Reads one value, returning false at the end
+    ///     of the file, including within the value.
+    template<typename T>
+    static bool read_value(
+        std::istream& a_istream,
+        T& a_value
+    )
+    {
+        return (bool)a_istream.read(reinterpret_cast<char*>(&a_value), sizeof(T));
+    }
+
+    /// Flushes the file or directory at the argued
+    ///     path through to the disk.
+    static void sync(
+        const std::string& a_path,
+        int a_flags
+    )
+    {
+        int l_descriptor = ::open(a_path.c_str(), O_RDONLY | a_flags);
+
+        if (l_descriptor < 0)
+            throw std::runtime_error("cannot open for sync: " + a_path);
+
+        int l_result = ::fsync(l_descriptor);
+
+        ::close(l_descriptor);
+
+        if (l_result != 0)
+            throw std::runtime_error("cannot sync: " + a_path);
+
+    }
+
+    checkpoint::checkpoint(
+        const std::string& a_path
+    ) :
+        m_path(a_path)
+    {
+        forget();
+
+        if (!std::filesystem::exists(a_path))
+        {
+            m_ofstream.open(a_path, std::ios::binary);
+
+            if (!m_ofstream)
+                throw std::runtime_error("cannot create checkpoint: " + a_path);
+
+            m_ofstream.write(MAGIC, 4);
+            write_value(m_ofstream, VERSION);
+            m_ofstream.flush();
+
+            if (!m_ofstream)
+                throw std::runtime_error("cannot write checkpoint: " + a_path);
+
+            /// The new entry must reach the directory
+            ///     too, or a crash may lose the file.
+            std::filesystem::path l_directory = std::filesystem::path(a_path).parent_path();
+
+            sync(a_path, 0);
+            sync(l_directory.empty() ? "." : l_directory.string(), O_DIRECTORY);
+
+            return;
+
+        }
+
+        std::ifstream l_ifstream(a_path, std::ios::binary);
+
+        char l_magic[4];
+        uint32_t l_version = 0;
+
+        if (!l_ifstream.read(l_magic, 4) || !std::equal(l_magic, l_magic + 4, MAGIC) ||
+            !read_value(l_ifstream, l_version) || l_version != VERSION)
+            throw std::runtime_error("not a checkpoint: " + a_path);
+
+        /// The nodes by identifier, and the state as
+        ///     of the last commit read.
+        std::vector<const node*> l_nodes = { ZERO, ONE };
+        std::map<std::string, std::pair<uint64_t, const node*>> l_pending_roots;
+
+        std::streamoff l_committed_offset = l_ifstream.tellg();
+        size_t l_committed_node_count = l_nodes.size();
+
+        dag* l_dag = global_node_sink::bound();
+
+        while (true)
+        {
+            tag l_tag;
+
+            if (!read_value(l_ifstream, l_tag))
+                break;
+
+            if (l_tag == tag::NODE)
+            {
+                uint32_t l_depth;
+                uint32_t l_chain;
+                uint64_t l_negative;
+                uint64_t l_positive;
+
+                if (!read_value(l_ifstream, l_depth) ||
+                    !read_value(l_ifstream, l_chain) ||
+                    !read_value(l_ifstream, l_negative) ||
+                    !read_value(l_ifstream, l_positive))
+                    break;
+
+                if (l_negative >= l_nodes.size() || l_positive >= l_nodes.size())
+                    throw std::runtime_error("corrupt checkpoint node: " + a_path);
+
+                node l_node(l_depth, l_nodes[l_negative], l_nodes[l_positive], l_chain);
+
+                if (l_node.chain_length() > node::MAX_CHAIN_LENGTH)
+                    throw std::runtime_error("corrupt checkpoint node: " + a_path);
+
+                /// A chain node is emplaced as its run, which
+                ///     the bound dag chains again if chained.
+                l_nodes.push_back(
+                    l_node.chain_length() != 0 ?
+                        l_dag->emplace_chain(&l_node, l_node.chain_terminal(), l_node.negative(), l_node.positive()) :
+                        l_dag->emplace(l_depth, l_node.negative(), l_node.positive())
+                );
+
+            }
+            else if (l_tag == tag::ROOT)
+            {
+                uint32_t l_length;
+                uint64_t l_identifier;
+
+                if (!read_value(l_ifstream, l_length))
+                    break;
+
+                std::string l_name(l_length, '\0');
+
+                if (!l_ifstream.read(l_name.data(), l_length) || !read_value(l_ifstream, l_identifier))
+                    break;
+
+                if (l_identifier >= l_nodes.size())
+                    throw std::runtime_error("corrupt checkpoint root: " + a_path);
+
+                l_pending_roots[l_name] = { l_identifier, l_nodes[l_identifier] };
+
+            }
+            else if (l_tag == tag::COMMIT)
+            {
+                uint64_t l_commits;
+
+                if (!read_value(l_ifstream, l_commits))
+                    break;
+
+                m_commits = l_commits;
+
+                for (const auto& [l_name, l_root] : l_pending_roots)
+                {
+                    m_root_identifiers[l_name] = l_root.first;
+                    m_roots[l_name] = l_root.second;
+                }
+
+                l_pending_roots.clear();
+
+                l_committed_offset = l_ifstream.tellg();
+                l_committed_node_count = l_nodes.size();
+
+            }
+            else
+            {
+                break;
+            }
+
+        }
+
+        l_ifstream.close();
+
+        /// Discard the uncommitted tail, so that the
+        ///     next save appends after the last commit.
+        l_nodes.resize(l_committed_node_count);
+
+        std::filesystem::resize_file(a_path, l_committed_offset);
+
+        for (uint64_t i = 2; i < l_nodes.size(); i++)
+            m_identifiers.insert_or_assign(l_nodes[i], i);
+
+        m_next_identifier = l_nodes.size();
+
+        m_ofstream.open(a_path, std::ios::binary | std::ios::app);
+
+        if (!m_ofstream)
+            throw std::runtime_error("cannot append to checkpoint: " + a_path);
+
+    }
+
+    void checkpoint::forget(
+
+    )
+    {
+        m_identifiers.clear();
+
+        m_identifiers.emplace(ZERO, 0);
+        m_identifiers.emplace(ONE, 1);
+
+        m_generation = global_node_sink::bound()->generation();
+
+    }
+
+    uint64_t checkpoint::write_node(
+        const node* a_node
+    )
+    {
+        auto l_it = m_identifiers.find(a_node);
+
+        if (l_it != m_identifiers.end())
+            return l_it->second;
+
+        uint64_t l_negative = write_node(a_node->negative());
+        uint64_t l_positive = write_node(a_node->positive());
+
+        write_value(m_ofstream, tag::NODE);
+        write_value(m_ofstream, a_node->depth());
+        write_value(m_ofstream, node::chain(a_node->chain_length(), a_node->chain_mask(), a_node->chain_terminal() == ONE));
+        write_value(m_ofstream, l_negative);
+        write_value(m_ofstream, l_positive);
+
+        uint64_t l_identifier = m_next_identifier++;
+
+        m_identifiers.emplace(a_node, l_identifier);
+
+        return l_identifier;
+
+    }
+
+    void checkpoint::save(
+        const std::map<std::string, const node*>& a_roots
+    )
+    {
+        forbid_leaves("checkpoint::save");
+
+        /// The dag was collected since the last save.
+        if (global_node_sink::bound()->generation() != m_generation)
+            forget();
+
+        for (const auto& [l_name, l_node] : a_roots)
+        {
+            uint64_t l_identifier = write_node(l_node);
+
+            auto l_it = m_root_identifiers.find(l_name);
+
+            /// Unchanged roots need no record.
+            if (l_it != m_root_identifiers.end() && l_it->second == l_identifier)
+                continue;
+
+            m_root_identifiers[l_name] = l_identifier;
+
+            write_value(m_ofstream, tag::ROOT);
+            write_value(m_ofstream, uint32_t(l_name.size()));
+            m_ofstream.write(l_name.data(), l_name.size());
+            write_value(m_ofstream, l_identifier);
+
+        }
+
+        write_value(m_ofstream, tag::COMMIT);
+        write_value(m_ofstream, ++m_commits);
+
+        m_ofstream.flush();
+
+        if (!m_ofstream)
+            throw std::runtime_error("cannot write checkpoint: " + m_path);
+
+        /// The commit is only durable once on disk.
+        sync(m_path, 0);
+
+        for (const auto& [l_name, l_node] : a_roots)
+            m_roots[l_name] = l_node;
+
+    }
+
+}
@@ -0,0 +1,1036 @@
+#include <assert.h>
+#include <queue>
+#include <array>
+#include <cstdio>
+#include <filesystem>
+
+#include "include/external.h"
+
+namespace factor::external
+{
+
+    ////////////////////////////////////////////
+    ///////////////// FILE I/O /////////////////
+    ////////////////////////////////////////////
+    #pragma region FILE I/O
+
+    static constexpr char MAGIC[4] = { 'F', 'C', 'T', 'X' };
+    static constexpr uint32_t VERSION = 1;
+
+    /// The magic, version, root, level count
+    ///     and level table offset.
+    static constexpr std::streamoff HEADER_BYTES = 4 + 4 + 8 + 8 + 8;
+
+    template<typename T>
+    static void write_value(
+        std::ostream& a_ostream,
+        const T& a_value
+    )
+    {
+        a_ostream.write(reinterpret_cast<const char*>(&a_value), sizeof(T));
+    }
+
+    template<typename T>
+    static T read_value(
+        std::istream& a_istream
+    )
+    {
+        T l_result;
+
+        if (!a_istream.read(reinterpret_cast<char*>(&l_result), sizeof(T)))
+            throw std::runtime_error("truncated external dag file");
+
+        return l_result;
+
+    }
+
+    diagram::diagram(
+        const std::string& a_path
+    ) :
+        m_path(a_path)
+    {
+        std::ifstream l_ifstream(a_path, std::ios::binary);
+
+        if (!l_ifstream)
+            throw std::runtime_error("cannot open external dag file: " + a_path);
+
+        char l_magic[4];
+
+        if (!l_ifstream.read(l_magic, 4) || !std::equal(l_magic, l_magic + 4, MAGIC))
+            throw std::runtime_error("not an external dag file: " + a_path);
+
+        if (read_value<uint32_t>(l_ifstream) != VERSION)
+            throw std::runtime_error("unsupported external dag version: " + a_path);
+
+        m_root = read_value<uint64_t>(l_ifstream);
+
+        uint64_t l_level_count = read_value<uint64_t>(l_ifstream);
+        uint64_t l_table_offset = read_value<uint64_t>(l_ifstream);
+
+        l_ifstream.seekg(l_table_offset);
+
+        for (uint64_t i = 0; i < l_level_count; i++)
+        {
+            level l_level;
+
+            l_level.m_depth = read_value<uint32_t>(l_ifstream);
+            l_level.m_count = read_value<uint64_t>(l_ifstream);
+            l_level.m_offset = read_value<uint64_t>(l_ifstream);
+
+            m_levels.push_back(l_level);
+
+        }
+
+    }
+
+    std::vector<record> diagram::read_level(
+        size_t a_level_index
+    ) const
+    {
+        std::ifstream l_ifstream(m_path, std::ios::binary);
+
+        l_ifstream.seekg(m_levels[a_level_index].m_offset);
+
+        std::vector<record> l_result(m_levels[a_level_index].m_count);
+
+        for (record& l_record : l_result)
+        {
+            l_record.m_uid = read_value<uint64_t>(l_ifstream);
+            l_record.m_negative = read_value<uint64_t>(l_ifstream);
+            l_record.m_positive = read_value<uint64_t>(l_ifstream);
+        }
+
+        return l_result;
+
+    }
+
+    writer::writer(
+        const std::string& a_path
+    ) :
+        m_ofstream(a_path, std::ios::binary | std::ios::trunc)
+    {
+        if (!m_ofstream)
+            throw std::runtime_error("cannot create external dag file: " + a_path);
+
+        /// Reserve the header, written once complete.
+        m_ofstream.seekp(HEADER_BYTES);
+
+    }
+
+    void writer::write_level(
+        uint32_t a_depth,
+        const std::vector<record>& a_records
+    )
+    {
+        m_levels.push_back({ a_depth, a_records.size(), uint64_t(m_ofstream.tellp()) });
+
+        for (const record& l_record : a_records)
+        {
+            write_value(m_ofstream, l_record.m_uid);
+            write_value(m_ofstream, l_record.m_negative);
+            write_value(m_ofstream, l_record.m_positive);
+        }
+
+    }
+
+    void writer::finish(
+        uint64_t a_root
+    )
+    {
+        std::sort(m_levels.begin(), m_levels.end(), [](const level& a_x, const level& a_y)
+        {
+            return a_x.m_depth < a_y.m_depth;
+        });
+
+        uint64_t l_table_offset = m_ofstream.tellp();
+
+        for (const level& l_level : m_levels)
+        {
+            write_value(m_ofstream, l_level.m_depth);
+            write_value(m_ofstream, l_level.m_count);
+            write_value(m_ofstream, l_level.m_offset);
+        }
+
+        m_ofstream.seekp(0);
+        m_ofstream.write(MAGIC, 4);
+
+        write_value(m_ofstream, VERSION);
+        write_value(m_ofstream, a_root);
+        write_value(m_ofstream, uint64_t(m_levels.size()));
+        write_value(m_ofstream, l_table_offset);
+
+        m_ofstream.close();
+
+        if (!m_ofstream)
+            throw std::runtime_error("failed writing external dag file");
+
+    }
+
+    /// Reads the levels of a diagram in increasing
+    ///     depth, holding only the current one.
+    class level_cursor
+    {
+        const diagram& m_diagram;
+        size_t m_next_level_index;
+        std::vector<record> m_records;
+
+    public:
+
+        level_cursor(
+            const diagram& a_diagram
+        ) :
+            m_diagram(a_diagram),
+            m_next_level_index(0)
+        {
+
+        }
+
+        /// Advances to the argued depth, which must
+        ///     exceed that of any previous call.
+        void seek(
+            uint32_t a_depth
+        )
+        {
+            const std::vector<level>& l_levels = m_diagram.levels();
+
+            while (m_next_level_index < l_levels.size() && l_levels[m_next_level_index].m_depth < a_depth)
+                m_next_level_index++;
+
+            m_records.clear();
+
+            if (m_next_level_index < l_levels.size() && l_levels[m_next_level_index].m_depth == a_depth)
+                m_records = m_diagram.read_level(m_next_level_index++);
+
+        }
+
+        const record* find(
+            uint64_t a_uid
+        ) const
+        {
+            auto l_it = std::lower_bound(m_records.begin(), m_records.end(), a_uid, [](const record& a_record, uint64_t a_uid)
+            {
+                return a_record.m_uid < a_uid;
+            });
+
+            assert(l_it != m_records.end() && l_it->m_uid == a_uid);
+
+            return &*l_it;
+
+        }
+
+    };
+
+    #pragma endregion
+
+    ////////////////////////////////////////////
+    ////////////////// SWEEPS //////////////////
+    ////////////////////////////////////////////
+    #pragma region SWEEPS
+
+    static constexpr uint64_t NO_PARENT = UINT64_MAX;
+
+    /// What a sweep does with one request: resolve it
+    ///     to a terminal, forward it to another pair,
+    ///     or emit a node at its depth with two pairs
+    ///     of children.
+    struct outcome
+    {
+        enum class kind
+        {
+            TERMINAL,
+            FORWARD,
+            NODE,
+        };
+
+        kind m_kind;
+        uint64_t m_terminal;
+        std::array<std::pair<uint64_t, uint64_t>, 2> m_children;
+
+    };
+
+    /// Decides the outcome of a request for the pair,
+    ///     given the records of those operands lying
+    ///     at the request's depth, or nullptr.
+    using step = std::function<outcome(
+        uint64_t a_x,
+        uint64_t a_y,
+        const record* a_x_record,
+        const record* a_y_record
+    )>;
+
+    /// A request to compute the pair, on behalf of
+    ///     one child of the parent node.
+    struct request
+    {
+        uint64_t m_x;
+        uint64_t m_y;
+        uint64_t m_parent;
+        bool m_positive;
+
+        uint32_t depth(
+
+        ) const
+        {
+            return std::min(depth_of(m_x), depth_of(m_y));
+        }
+
+        bool operator>(
+            const request& a_other
+        ) const
+        {
+            return
+                std::make_tuple(depth(), m_x, m_y) >
+                std::make_tuple(a_other.depth(), a_other.m_x, a_other.m_y);
+        }
+
+    };
+
+    /// An arc from a parent to its child.
+    struct arc
+    {
+        uint64_t m_parent;
+        uint64_t m_positive;
+        uint64_t m_child;
+
+        bool operator<(
+            const arc& a_other
+        ) const
+        {
+            return m_parent < a_other.m_parent;
+        }
+
+    };
+
+    /// The arcs into the terminals, which the top-down
+    ///     sweep resolves in no useful order. They are
+    ///     spilled to a file in sorted runs of bounded
+    ///     length, and merged back deepest parent first
+    ///     during the reduction, so that memory holds a
+    ///     read buffer per run rather than every arc.
+    class terminal_arcs
+    {
+        static constexpr size_t RUN_ARCS = size_t(1) << 16;
+        static constexpr size_t READ_ARCS = 1024;
+
+        struct run
+        {
+            uint64_t m_offset;
+            uint64_t m_end;
+            std::vector<arc> m_buffer;
+            size_t m_next;
+        };
+
+        std::string m_path;
+        std::fstream m_fstream;
+
+        /// The arcs not yet spilled.
+        std::vector<arc> m_pending;
+
+        std::vector<run> m_runs;
+
+        /// The next arc of each run, deepest parent first.
+        std::priority_queue<std::pair<arc, size_t>> m_heads;
+
+        void spill(
+
+        )
+        {
+            if (m_pending.empty())
+                return;
+
+            std::sort(m_pending.begin(), m_pending.end(), [](const arc& a_x, const arc& a_y)
+            {
+                return a_y < a_x;
+            });
+
+            uint64_t l_offset = m_fstream.tellp();
+
+            for (const arc& l_arc : m_pending)
+            {
+                write_value(m_fstream, l_arc.m_parent);
+                write_value(m_fstream, l_arc.m_positive);
+                write_value(m_fstream, l_arc.m_child);
+            }
+
+            m_runs.push_back({ l_offset, uint64_t(m_fstream.tellp()), {}, 0 });
+
+            m_pending.clear();
+
+        }
+
+        /// Reads the next buffer of the run once the
+        ///     last is consumed, and queues its head.
+        void advance(
+            size_t a_run_index
+        )
+        {
+            run& l_run = m_runs[a_run_index];
+
+            if (l_run.m_next == l_run.m_buffer.size() && l_run.m_offset < l_run.m_end)
+            {
+                l_run.m_buffer.clear();
+                l_run.m_next = 0;
+
+                m_fstream.seekg(l_run.m_offset);
+
+                for (; l_run.m_offset < l_run.m_end && l_run.m_buffer.size() < READ_ARCS; l_run.m_offset += sizeof(arc))
+                {
+                    uint64_t l_parent = read_value<uint64_t>(m_fstream);
+                    uint64_t l_positive = read_value<uint64_t>(m_fstream);
+                    uint64_t l_child = read_value<uint64_t>(m_fstream);
+
+                    l_run.m_buffer.push_back({ l_parent, l_positive, l_child });
+
+                }
+
+            }
+
+            if (l_run.m_next < l_run.m_buffer.size())
+                m_heads.emplace(l_run.m_buffer[l_run.m_next], a_run_index);
+
+        }
+
+    public:
+
+        terminal_arcs(
+            const std::string& a_path
+        ) :
+            m_path(a_path),
+            m_fstream(a_path, std::ios::binary | std::ios::in | std::ios::out | std::ios::trunc)
+        {
+            if (!m_fstream)
+                throw std::runtime_error("cannot create temporary file: " + a_path);
+        }
+
+        ~terminal_arcs(
+
+        )
+        {
+            m_fstream.close();
+            std::remove(m_path.c_str());
+        }
+
+        void push(
+            const arc& a_arc
+        )
+        {
+            m_pending.push_back(a_arc);
+
+            if (m_pending.size() == RUN_ARCS)
+                spill();
+
+        }
+
+        /// Ends the pushes and begins the merge.
+        void rewind(
+
+        )
+        {
+            spill();
+
+            m_pending.shrink_to_fit();
+            m_fstream.flush();
+
+            for (size_t i = 0; i < m_runs.size(); i++)
+                advance(i);
+
+        }
+
+        bool empty(
+
+        ) const
+        {
+            return m_heads.empty();
+        }
+
+        const arc& top(
+
+        ) const
+        {
+            return m_heads.top().first;
+        }
+
+        void pop(
+
+        )
+        {
+            size_t l_run_index = m_heads.top().second;
+
+            m_heads.pop();
+
+            m_runs[l_run_index].m_next++;
+
+            advance(l_run_index);
+
+        }
+
+    };
+
+    /// Runs the top-down sweep, which emits the
+    ///     unreduced nodes one depth at a time along
+    ///     with the arcs into them, and then the
+    ///     bottom-up reduction, which merges equal
+    ///     nodes and drops redundant ones, writing
+    ///     each depth of the result as it completes.
+    static void sweep(
+        const step& a_step,
+        level_cursor& a_x_cursor,
+        level_cursor* a_y_cursor,
+        uint64_t a_x_root,
+        uint64_t a_y_root,
+        const std::string& a_output_path
+    )
+    {
+        /// The arcs into the unreduced nodes, written
+        ///     in increasing depth of their child.
+        std::string l_arcs_path = a_output_path + ".arcs";
+        std::fstream l_arcs(l_arcs_path, std::ios::binary | std::ios::in | std::ios::out | std::ios::trunc);
+
+        if (!l_arcs)
+            throw std::runtime_error("cannot create temporary file: " + l_arcs_path);
+
+        /// Each unreduced level, as its depth, node
+        ///     count, and the offset of its arcs.
+        std::vector<level> l_levels;
+
+        std::priority_queue<request, std::vector<request>, std::greater<request>> l_requests;
+
+        /// The arcs the top-down sweep resolves to a
+        ///     terminal, held on disk until the reduction.
+        terminal_arcs l_terminal_arcs(a_output_path + ".terminals");
+
+        /// Reduced children, forwarded to their parents
+        ///     during the reduction, deepest parents first.
+        std::priority_queue<arc> l_forwards;
+
+        uint64_t l_root = NO_PARENT;
+
+        /// Resolves a request of the top-down sweep
+        ///     to a terminal.
+        const auto l_resolve = [&](
+            uint64_t a_parent,
+            bool a_positive,
+            uint64_t a_terminal
+        )
+        {
+            if (a_parent == NO_PARENT)
+                l_root = a_terminal;
+            else
+                l_terminal_arcs.push({ a_parent, a_positive, a_terminal });
+        };
+
+        /// Forwards a reduced node to its parent.
+        const auto l_forward = [&](
+            uint64_t a_parent,
+            bool a_positive,
+            uint64_t a_child
+        )
+        {
+            if (a_parent == NO_PARENT)
+                l_root = a_child;
+            else
+                l_forwards.push({ a_parent, a_positive, a_child });
+        };
+
+        const auto l_request = [&](
+            uint64_t a_x,
+            uint64_t a_y,
+            uint64_t a_parent,
+            bool a_positive
+        )
+        {
+            /// Pairs of terminals are resolved at once,
+            ///     rather than queued behind every node.
+            if (is_terminal(a_x) && is_terminal(a_y))
+            {
+                outcome l_outcome = a_step(a_x, a_y, nullptr, nullptr);
+
+                assert(l_outcome.m_kind == outcome::kind::TERMINAL);
+
+                l_resolve(a_parent, a_positive, l_outcome.m_terminal);
+
+                return;
+
+            }
+
+            l_requests.push({ a_x, a_y, a_parent, a_positive });
+
+        };
+
+        l_request(a_x_root, a_y_root, NO_PARENT, false);
+
+        while (!l_requests.empty())
+        {
+            uint32_t l_depth = l_requests.top().depth();
+
+            a_x_cursor.seek(l_depth);
+
+            if (a_y_cursor != nullptr)
+                a_y_cursor->seek(l_depth);
+
+            level l_level = { l_depth, 0, uint64_t(l_arcs.tellp()) };
+
+            while (!l_requests.empty() && l_requests.top().depth() == l_depth)
+            {
+                uint64_t l_x = l_requests.top().m_x;
+                uint64_t l_y = l_requests.top().m_y;
+
+                /// Every request for the same pair is
+                ///     served by a single outcome.
+                std::vector<std::pair<uint64_t, bool>> l_parents;
+
+                while (!l_requests.empty() && l_requests.top().m_x == l_x && l_requests.top().m_y == l_y)
+                {
+                    l_parents.emplace_back(l_requests.top().m_parent, l_requests.top().m_positive);
+                    l_requests.pop();
+                }
+
+                outcome l_outcome = a_step(
+                    l_x,
+                    l_y,
+                    depth_of(l_x) == l_depth ? a_x_cursor.find(l_x) : nullptr,
+                    depth_of(l_y) == l_depth ? a_y_cursor->find(l_y) : nullptr
+                );
+
+                switch (l_outcome.m_kind)
+                {
+                    case outcome::kind::TERMINAL:
+                    {
+                        for (const auto& [l_parent, l_positive] : l_parents)
+                            l_resolve(l_parent, l_positive, l_outcome.m_terminal);
+
+                        break;
+
+                    }
+                    case outcome::kind::FORWARD:
+                    {
+                        const auto& [l_child_x, l_child_y] = l_outcome.m_children[0];
+
+                        for (const auto& [l_parent, l_positive] : l_parents)
+                            l_request(l_child_x, l_child_y, l_parent, l_positive);
+
+                        break;
+
+                    }
+                    case outcome::kind::NODE:
+                    {
+                        uint64_t l_uid = make_uid(l_depth, l_level.m_count++);
+
+                        for (const auto& [l_parent, l_positive] : l_parents)
+                        {
+                            write_value(l_arcs, l_parent);
+                            write_value(l_arcs, uint64_t(l_positive));
+                            write_value(l_arcs, l_uid);
+                        }
+
+                        l_request(l_outcome.m_children[0].first, l_outcome.m_children[0].second, l_uid, false);
+                        l_request(l_outcome.m_children[1].first, l_outcome.m_children[1].second, l_uid, true);
+
+                        break;
+
+                    }
+                }
+
+            }
+
+            if (l_level.m_count > 0)
+                l_levels.push_back(l_level);
+
+        }
+
+        uint64_t l_arcs_size = l_arcs.tellp();
+
+        l_terminal_arcs.rewind();
+
+        writer l_writer(a_output_path);
+
+        for (auto l_it = l_levels.rbegin(); l_it != l_levels.rend(); l_it++)
+        {
+            std::vector<std::array<uint64_t, 2>> l_children(l_it->m_count);
+
+            while (!l_terminal_arcs.empty() && depth_of(l_terminal_arcs.top().m_parent) == l_it->m_depth)
+            {
+                const arc& l_arc = l_terminal_arcs.top();
+
+                l_children[index_of(l_arc.m_parent)][l_arc.m_positive] = l_arc.m_child;
+
+                l_terminal_arcs.pop();
+
+            }
+
+            while (!l_forwards.empty() && depth_of(l_forwards.top().m_parent) == l_it->m_depth)
+            {
+                const arc& l_arc = l_forwards.top();
+
+                l_children[index_of(l_arc.m_parent)][l_arc.m_positive] = l_arc.m_child;
+
+                l_forwards.pop();
+
+            }
+
+            /// Redundant nodes are replaced by their child,
+            ///     and the rest are merged by sorting.
+            std::vector<uint64_t> l_reduced(l_it->m_count);
+            std::vector<std::tuple<uint64_t, uint64_t, uint32_t>> l_distinct;
+
+            for (uint32_t i = 0; i < l_it->m_count; i++)
+            {
+                if (l_children[i][0] == l_children[i][1])
+                    l_reduced[i] = l_children[i][0];
+                else
+                    l_distinct.emplace_back(l_children[i][0], l_children[i][1], i);
+            }
+
+            std::sort(l_distinct.begin(), l_distinct.end());
+
+            std::vector<record> l_records;
+
+            for (const auto& [l_negative, l_positive, l_index] : l_distinct)
+            {
+                if (l_records.empty() || l_records.back().m_negative != l_negative || l_records.back().m_positive != l_positive)
+                    l_records.push_back({ make_uid(l_it->m_depth, l_records.size()), l_negative, l_positive });
+
+                l_reduced[l_index] = l_records.back().m_uid;
+
+            }
+
+            if (!l_records.empty())
+                l_writer.write_level(l_it->m_depth, l_records);
+
+            /// Forward the reduced nodes to their parents.
+            uint64_t l_arcs_end = l_it == l_levels.rbegin() ? l_arcs_size : std::prev(l_it)->m_offset;
+
+            l_arcs.seekg(l_it->m_offset);
+
+            for (uint64_t l_offset = l_it->m_offset; l_offset < l_arcs_end; l_offset += sizeof(arc))
+            {
+                uint64_t l_parent = read_value<uint64_t>(l_arcs);
+                uint64_t l_positive = read_value<uint64_t>(l_arcs);
+                uint64_t l_child = read_value<uint64_t>(l_arcs);
+
+                l_forward(l_parent, l_positive != 0, l_reduced[index_of(l_child)]);
+
+            }
+
+        }
+
+        l_arcs.close();
+        std::remove(l_arcs_path.c_str());
+
+        l_writer.finish(l_root);
+
+    }
+
+    #pragma endregion
+
+    ////////////////////////////////////////////
+    //////////////// ALGORITHMS ////////////////
+    ////////////////////////////////////////////
+    #pragma region ALGORITHMS
+
+    /// Throws if writing the output would truncate
+    ///     an input before it has been read.
+    static void check_distinct(
+        const std::string& a_input_path,
+        const std::string& a_output_path
+    )
+    {
+        if (a_input_path == a_output_path ||
+            (std::filesystem::exists(a_output_path) && std::filesystem::equivalent(a_input_path, a_output_path)))
+            throw std::runtime_error("output overwrites input: " + a_output_path);
+    }
+
+    void from_dag(
+        const node* a_node,
+        const std::string& a_path
+    )
+    {
+        forbid_chains("external::from_dag");
+        forbid_leaves("external::from_dag");
+
+        std::map<const node*, uint64_t> l_uids = { { ZERO, ZERO_UID }, { ONE, ONE_UID } };
+
+        /// Gather the nodes of each depth.
+        std::map<uint32_t, std::vector<const node*>> l_depths;
+        std::set<const node*> l_visited;
+        std::stack<const node*> l_stack;
+
+        l_stack.push(a_node);
+
+        while (!l_stack.empty())
+        {
+            const node* l_node = l_stack.top();
+            l_stack.pop();
+
+            if (l_node == ZERO || l_node == ONE || !l_visited.insert(l_node).second)
+                continue;
+
+            l_depths[l_node->depth()].push_back(l_node);
+            l_stack.push(l_node->negative());
+            l_stack.push(l_node->positive());
+
+        }
+
+        writer l_writer(a_path);
+
+        /// Number the nodes as the reduction does,
+        ///     in the sorted order of their children.
+        for (auto l_it = l_depths.rbegin(); l_it != l_depths.rend(); l_it++)
+        {
+            std::vector<std::tuple<uint64_t, uint64_t, const node*>> l_sorted;
+
+            for (const node* l_node : l_it->second)
+                l_sorted.emplace_back(l_uids[l_node->negative()], l_uids[l_node->positive()], l_node);
+
+            std::sort(l_sorted.begin(), l_sorted.end());
+
+            std::vector<record> l_records;
+
+            for (const auto& [l_negative, l_positive, l_node] : l_sorted)
+            {
+                l_records.push_back({ make_uid(l_it->first, l_records.size()), l_negative, l_positive });
+                l_uids[l_node] = l_records.back().m_uid;
+            }
+
+            l_writer.write_level(l_it->first, l_records);
+
+        }
+
+        l_writer.finish(l_uids[a_node]);
+
+    }
+
+    const node* to_dag(
+        const std::string& a_path
+    )
+    {
+        diagram l_diagram(a_path);
+
+        std::map<uint64_t, const node*> l_nodes = { { ZERO_UID, ZERO }, { ONE_UID, ONE } };
+
+        for (size_t i = l_diagram.levels().size(); i-- > 0;)
+            for (const record& l_record : l_diagram.read_level(i))
+                l_nodes[l_record.m_uid] = global_node_sink::bound()->emplace(
+                    depth_of(l_record.m_uid),
+                    l_nodes.at(l_record.m_negative),
+                    l_nodes.at(l_record.m_positive)
+                );
+
+        return l_nodes.at(l_diagram.root());
+
+    }
+
+    void invert(
+        const std::string& a_input_path,
+        const std::string& a_output_path
+    )
+    {
+        diagram l_diagram(a_input_path);
+
+        check_distinct(a_input_path, a_output_path);
+
+        const auto l_invert = [](uint64_t a_uid)
+        {
+            if (a_uid == ZERO_UID)
+                return ONE_UID;
+            if (a_uid == ONE_UID)
+                return ZERO_UID;
+
+            return a_uid;
+
+        };
+
+        writer l_writer(a_output_path);
+
+        for (size_t i = 0; i < l_diagram.levels().size(); i++)
+        {
+            std::vector<record> l_records = l_diagram.read_level(i);
+
+            for (record& l_record : l_records)
+            {
+                l_record.m_negative = l_invert(l_record.m_negative);
+                l_record.m_positive = l_invert(l_record.m_positive);
+            }
+
+            l_writer.write_level(l_diagram.levels()[i].m_depth, l_records);
+
+        }
+
+        l_writer.finish(l_invert(l_diagram.root()));
+
+    }
+
+    void apply(
+        operation a_operation,
+        const std::string& a_x_path,
+        const std::string& a_y_path,
+        const std::string& a_output_path
+    )
+    {
+        diagram l_x(a_x_path);
+        diagram l_y(a_y_path);
+
+        check_distinct(a_x_path, a_output_path);
+        check_distinct(a_y_path, a_output_path);
+
+        level_cursor l_x_cursor(l_x);
+        level_cursor l_y_cursor(l_y);
+
+        const auto l_result = [a_operation](bool a_x, bool a_y)
+        {
+            return ((uint8_t)a_operation >> (2 * a_x + a_y) & 0x1) ? ONE_UID : ZERO_UID;
+        };
+
+        step l_step = [&l_result](
+            uint64_t a_x,
+            uint64_t a_y,
+            const record* a_x_record,
+            const record* a_y_record
+        )
+        {
+            /// A terminal operand resolves the request
+            ///     if the result no longer depends on
+            ///     the other operand.
+            if (is_terminal(a_x) && l_result(a_x == ONE_UID, false) == l_result(a_x == ONE_UID, true))
+                return outcome{ outcome::kind::TERMINAL, l_result(a_x == ONE_UID, false), {} };
+            if (is_terminal(a_y) && l_result(false, a_y == ONE_UID) == l_result(true, a_y == ONE_UID))
+                return outcome{ outcome::kind::TERMINAL, l_result(false, a_y == ONE_UID), {} };
+            if (is_terminal(a_x) && is_terminal(a_y))
+                return outcome{ outcome::kind::TERMINAL, l_result(a_x == ONE_UID, a_y == ONE_UID), {} };
+
+            outcome l_outcome = { outcome::kind::NODE, 0, {} };
+
+            l_outcome.m_children[0] = {
+                a_x_record ? a_x_record->m_negative : a_x,
+                a_y_record ? a_y_record->m_negative : a_y,
+            };
+            l_outcome.m_children[1] = {
+                a_x_record ? a_x_record->m_positive : a_x,
+                a_y_record ? a_y_record->m_positive : a_y,
+            };
+
+            return l_outcome;
+
+        };
+
+        sweep(l_step, l_x_cursor, &l_y_cursor, l_x.root(), l_y.root(), a_output_path);
+
+    }
+
+    void restrict(
+        const std::string& a_input_path,
+        const std::map<uint32_t, bool>& a_assignment,
+        const std::string& a_output_path
+    )
+    {
+        diagram l_diagram(a_input_path);
+
+        check_distinct(a_input_path, a_output_path);
+
+        level_cursor l_cursor(l_diagram);
+
+        /// The second operand is an unused terminal.
+        step l_step = [&a_assignment](
+            uint64_t a_x,
+            uint64_t a_y,
+            const record* a_x_record,
+            const record*
+        )
+        {
+            if (is_terminal(a_x))
+                return outcome{ outcome::kind::TERMINAL, a_x, {} };
+
+            auto l_value = a_assignment.find(depth_of(a_x));
+
+            if (l_value != a_assignment.end())
+            {
+                outcome l_outcome = { outcome::kind::FORWARD, 0, {} };
+
+                l_outcome.m_children[0] = {
+                    l_value->second ? a_x_record->m_positive : a_x_record->m_negative,
+                    a_y
+                };
+
+                return l_outcome;
+
+            }
+
+            outcome l_outcome = { outcome::kind::NODE, 0, {} };
+
+            l_outcome.m_children[0] = { a_x_record->m_negative, a_y };
+            l_outcome.m_children[1] = { a_x_record->m_positive, a_y };
+
+            return l_outcome;
+
+        };
+
+        sweep(l_step, l_cursor, nullptr, l_diagram.root(), ZERO_UID, a_output_path);
+
+    }
+
+    double sat_count(
+        const std::string& a_path,
+        uint32_t a_variable_count
+    )
+    {
+        diagram l_diagram(a_path);
+
+        level_cursor l_cursor(l_diagram);
+
+        /// The probability of reaching each node under
+        ///     a uniformly random assignment, flowing
+        ///     from the root down to ONE.
+        std::priority_queue<
+            std::pair<uint64_t, double>,
+            std::vector<std::pair<uint64_t, double>>,
+            std::greater<std::pair<uint64_t, double>>
+        > l_masses;
+
+        double l_result = 0.0;
+
+        const auto l_send = [&](
+            uint64_t a_uid,
+            double a_mass
+        )
+        {
+            if (a_uid == ONE_UID)
+                l_result += a_mass;
+            else if (!is_terminal(a_uid))
+                l_masses.emplace(a_uid, a_mass);
+        };
+
+        l_send(l_diagram.root(), 1.0);
+
+        while (!l_masses.empty())
+        {
+            uint32_t l_depth = depth_of(l_masses.top().first);
+
+            l_cursor.seek(l_depth);
+
+            while (!l_masses.empty() && depth_of(l_masses.top().first) == l_depth)
+            {
+                uint64_t l_uid = l_masses.top().first;
+                double l_mass = 0.0;
+
+                while (!l_masses.empty() && l_masses.top().first == l_uid)
+                {
+                    l_mass += l_masses.top().second;
+                    l_masses.pop();
+                }
+
+                const record* l_record = l_cursor.find(l_uid);
+
+                l_send(l_record->m_negative, l_mass / 2.0);
+                l_send(l_record->m_positive, l_mass / 2.0);
+
+            }
+
+        }
+
+        return std::ldexp(l_result, a_variable_count);
+
+    }
+
+    #pragma endregion
+
+}
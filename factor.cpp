@@ -4,42 +4,159 @@
 
 namespace factor
 {
-    std::ostream& operator<<(
+    /// Prints the table of a leaf exactly as
+    ///     operator<< prints the subgraph it replaces,
+    ///     splitting on each variable, from the argued
+    ///     index onwards, on which the table depends.
+    static void print_table(
         std::ostream& a_ostream,
-        const node* a_node
+        uint64_t a_table,
+        uint32_t a_first_depth,
+        uint32_t a_width,
+        uint32_t a_index
     )
     {
         /// Do not print base cases.
-        if (a_node == ZERO || a_node == ONE)
-            return a_ostream;
+        if (a_table == 0 || a_table == leaf_mask(a_width))
+            return;
+
+        uint64_t l_negative = a_table;
+        uint64_t l_positive = a_table;
+
+        /// Skip the variables the table ignores.
+        for (; l_negative == l_positive; a_index++)
+        {
+            uint64_t l_mask = leaf_variable_mask(a_index);
+            uint32_t l_shift = 1 << a_index;
+
+            l_negative = (a_table & ~l_mask) | ((a_table & ~l_mask) << l_shift);
+            l_positive = (a_table & l_mask) | ((a_table & l_mask) >> l_shift);
+
+        }
+
+        uint32_t l_depth = a_first_depth + a_index - 1;
+
+        if (l_negative != 0 && l_positive != 0)
+            a_ostream << "(";
+
+        if (l_negative != 0)
+        {
+            a_ostream << "[" << l_depth << "]'";
+            print_table(a_ostream, l_negative, a_first_depth, a_width, a_index);
+        }
+
+        if (l_negative != 0 && l_positive != 0)
+            a_ostream << "+";
+
+        if (l_positive != 0)
+        {
+            a_ostream << "[" << l_depth << "]";
+            print_table(a_ostream, l_positive, a_first_depth, a_width, a_index);
+        }
+
+        if (l_negative != 0 && l_positive != 0)
+            a_ostream << ")";
+
+    }
 
+    /// Prints a split on the argued depth between
+    ///     the argued children.
+    static void print_split(
+        std::ostream& a_ostream,
+        uint32_t a_depth,
+        const node* a_negative,
+        const node* a_positive
+    )
+    {
         /// Only print bounding parens if BOTH children
         ///     are non-zero quantities.
-        if (a_node->negative() != ZERO && a_node->positive() != ZERO)
+        if (a_negative != ZERO && a_positive != ZERO)
             a_ostream << "(";
 
         /// Negative case. Print an apostrophe to indicate.
-        if (a_node->negative() != ZERO)
-            a_ostream << "[" << a_node->depth() << "]'" << a_node->negative();
+        if (a_negative != ZERO)
+            a_ostream << "[" << a_depth << "]'" << a_negative;
 
         /// Only print disjunction if BOTH children
         ///     are non-zero quantities.
-        if (a_node->negative() != ZERO && a_node->positive() != ZERO)
+        if (a_negative != ZERO && a_positive != ZERO)
             a_ostream << "+";
 
         /// Positive case. Omit apostrophe to indicate.
-        if (a_node->positive() != ZERO)
-            a_ostream << "[" << a_node->depth() << "]" << a_node->positive();
+        if (a_positive != ZERO)
+            a_ostream << "[" << a_depth << "]" << a_positive;
 
         /// Closing paren.
-        if (a_node->negative() != ZERO && a_node->positive() != ZERO)
+        if (a_negative != ZERO && a_positive != ZERO)
             a_ostream << ")";
-        
+
+    }
+
+    /// Prints a chain node, from the argued step of
+    ///     its run onwards, exactly as operator<< prints
+    ///     the run of ordinary nodes it replaces.
+    static void print_chain(
+        std::ostream& a_ostream,
+        const node* a_node,
+        uint32_t a_step
+    )
+    {
+        if (a_step == a_node->chain_length())
+        {
+            print_split(a_ostream, a_node->depth() + a_step, a_node->negative(), a_node->positive());
+            return;
+        }
+
+        uint32_t l_depth = a_node->depth() + a_step;
+        bool l_positive = ((a_node->chain_mask() >> a_step) & 0x1) != 0;
+
+        /// Off the chain lies ZERO, which is not printed.
+        if (a_node->chain_terminal() == ZERO)
+        {
+            a_ostream << "[" << l_depth << (l_positive ? "]" : "]'");
+            print_chain(a_ostream, a_node, a_step + 1);
+            return;
+        }
+
+        /// Off the chain lies ONE, which prints empty.
+        a_ostream << "([" << l_depth << "]'";
+
+        if (l_positive)
+            a_ostream << "+[" << l_depth << "]";
+
+        print_chain(a_ostream, a_node, a_step + 1);
+
+        if (!l_positive)
+            a_ostream << "+[" << l_depth << "]";
+
+        a_ostream << ")";
+
+    }
+
+    std::ostream& operator<<(
+        std::ostream& a_ostream,
+        const node* a_node
+    )
+    {
+        /// Do not print base cases.
+        if (a_node == ZERO || a_node == ONE)
+            return a_ostream;
+
+        if (a_node->is_leaf())
+        {
+            print_table(a_ostream, a_node->table(), a_node->leaf_depth(), a_node->leaf_width(), 0);
+            return a_ostream;
+        }
+
+        print_chain(a_ostream, a_node, 0);
+
         return a_ostream;
         
     }
 
-    std::istream& operator>>(
+    /// Parses one level of the expression, recursing
+    ///     into each subexpression.
+    static std::istream& parse(
         std::istream& a_istream,
         const node*& a_node
     )
@@ -61,7 +178,7 @@ namespace factor
                 {
                     /// This will pop the entire subexpression,
                     ///     including the associated closing paren.
-                    a_istream >> l_subexpression;
+                    parse(a_istream, l_subexpression);
 
                     break;
                 
@@ -84,7 +201,7 @@ namespace factor
                 {
                     /// Should pop entire expression of this
                     ///     level, starting from + until end.
-                    a_istream >> l_subexpression;
+                    parse(a_istream, l_subexpression);
                     
                     a_node = logic::disjoin(a_node, l_subexpression);
                     
@@ -116,11 +233,30 @@ namespace factor
             a_node = logic::conjoin(a_node, l_subexpression);
             
         }
-        
+
         return a_istream;
         
     }
 
+    /// Only the outermost level is traced, as one
+    ///     event spanning the whole expression.
+    std::istream& operator>>(
+        std::istream& a_istream,
+        const node*& a_node
+    )
+    {
+        FACTOR_TRACE_SCOPE(l_scope, "parse", global_node_sink::bound()->size(), 0);
+
+        parse(a_istream, a_node);
+
+        FACTOR_TRACE_FINISH(l_scope, global_node_sink::bound()->size(), FACTOR_TRACE_SIZE(node_count(a_node)));
+
+        return a_istream;
+
+    }
+
     dag* global_node_sink::s_graph(nullptr);
 
+    join_engine global_join_engine::s_engine(join_engine::DEPTH_FIRST);
+
 }
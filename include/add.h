@@ -0,0 +1,417 @@
+#ifndef ADD_H
+#define ADD_H
+
+#include <list>
+
+#include "factor.h"
+
+/// Algebraic DAGs represent functions from the
+///     Boolean variables to arbitrary values, such
+///     as integers or doubles, with one terminal
+///     node per distinct value.
+namespace factor::add
+{
+
+    ////////////////////////////////////////////
+    ////////////// DATA STRUCTURES /////////////
+    ////////////////////////////////////////////
+    #pragma region DATA STRUCTURES
+
+    template<typename T>
+    class node
+    {
+        /// Defines the depth of the node in the tree.
+        ///     Terminals lie deeper than any variable.
+        uint32_t m_depth;
+
+        /// Defines the subtrees.
+        const node* m_negative;
+        const node* m_positive;
+
+        /// Defines the value of a terminal.
+        T m_value;
+
+    public:
+
+        node(
+            T a_value
+        ) :
+            m_depth(UINT32_MAX),
+            m_negative(nullptr),
+            m_positive(nullptr),
+            m_value(a_value)
+        {
+
+        }
+
+        node(
+            uint32_t a_depth,
+            const node* a_left_child,
+            const node* a_right_child
+        ) :
+            m_depth(a_depth),
+            m_negative(a_left_child),
+            m_positive(a_right_child),
+            m_value()
+        {
+
+        }
+
+        uint32_t depth(
+
+        ) const
+        {
+            return m_depth;
+        }
+
+        const node* negative(
+
+        ) const
+        {
+            return m_negative;
+        }
+
+        const node* positive(
+
+        ) const
+        {
+            return m_positive;
+        }
+
+        T value(
+
+        ) const
+        {
+            return m_value;
+        }
+
+        bool terminal(
+
+        ) const
+        {
+            return m_depth == UINT32_MAX;
+        }
+
+        bool operator<(
+            const node& a_other
+        ) const
+        {
+            if (m_depth != a_other.m_depth)
+                return m_depth < a_other.m_depth;
+
+            if (m_negative != a_other.m_negative)
+                return m_negative < a_other.m_negative;
+
+            if (m_positive != a_other.m_positive)
+                return m_positive < a_other.m_positive;
+
+            return m_value < a_other.m_value;
+
+        }
+
+    };
+
+    template<typename T>
+    struct dag
+    {
+        dag(
+
+        )
+        {
+
+        }
+
+        /// We disallow copying for the same
+        ///     reason as factor::dag does.
+        dag(
+            const dag&
+        ) = delete;
+
+        dag& operator=(
+            const dag&
+        ) = delete;
+
+        size_t size(
+
+        ) const
+        {
+            return m_nodes.size();
+        }
+
+        const node<T>* terminal(
+            T a_value
+        )
+        {
+            return &*m_nodes.emplace(a_value).first;
+        }
+
+        const node<T>* emplace(
+            uint32_t a_depth,
+            const node<T>* a_negative_child,
+            const node<T>* a_positive_child
+        )
+        {
+            if (a_negative_child == a_positive_child)
+                return a_negative_child;
+
+            return &*m_nodes.emplace(
+                a_depth,
+                a_negative_child,
+                a_positive_child
+            ).first;
+
+        }
+
+    private:
+        std::set<node<T>> m_nodes;
+
+    };
+
+    template<typename T>
+    class global_node_sink
+    {
+        static inline dag<T>* s_graph = nullptr;
+
+    public:
+        static void bind(
+            dag<T>* a_graph
+        )
+        {
+            s_graph = a_graph;
+        }
+
+        static dag<T>* bound(
+
+        )
+        {
+            return s_graph;
+        }
+
+    };
+
+    enum class comparison
+    {
+        EQUAL,
+        NOT_EQUAL,
+        LESS,
+        LESS_EQUAL,
+        GREATER,
+        GREATER_EQUAL,
+    };
+
+    #pragma endregion
+
+    ////////////////////////////////////////////
+    //////////////// ALGORITHMS ////////////////
+    ////////////////////////////////////////////
+    #pragma region ALGORITHMS
+
+    template<typename T>
+    inline const node<T>* constant(
+        T a_value
+    )
+    {
+        return global_node_sink<T>::bound()->terminal(a_value);
+    }
+
+    /// Converts a factor DAG into the algebraic
+    ///     DAG taking the values zero and one.
+    template<typename T>
+    inline const node<T>* from_dag(
+        std::map<const factor::node*, const node<T>*>& a_cache,
+        const factor::node* a_node
+    )
+    {
+        if (a_node == factor::ZERO)
+            return constant<T>(0);
+        if (a_node == factor::ONE)
+            return constant<T>(1);
+
+        factor::forbid_leaves("add::from_dag");
+
+        return CACHE(
+            a_cache,
+            a_node,
+            global_node_sink<T>::bound()->emplace(
+                a_node->depth(),
+                from_dag(a_cache, factor::global_node_sink::bound()->negative(a_node)),
+                from_dag(a_cache, factor::global_node_sink::bound()->positive(a_node))
+            )
+        );
+
+    }
+
+    /// Applies the argued binary operation to the
+    ///     values of two algebraic DAGs. The cache
+    ///     must only be shared between calls
+    ///     applying the same operation.
+    template<typename T, typename OPERATION>
+    inline const node<T>* apply(
+        std::map<std::pair<const node<T>*, const node<T>*>, const node<T>*>& a_cache,
+        const OPERATION& a_operation,
+        const node<T>* a_x,
+        const node<T>* a_y
+    )
+    {
+        if (a_x->terminal() && a_y->terminal())
+            return constant<T>(a_operation(a_x->value(), a_y->value()));
+
+        std::pair<const node<T>*, const node<T>*> l_key = { a_x, a_y };
+
+        if (a_cache.contains(l_key))
+            return a_cache[l_key];
+
+        const node<T>* l_x_left = a_x->negative();
+        const node<T>* l_y_left = a_y->negative();
+        const node<T>* l_x_right = a_x->positive();
+        const node<T>* l_y_right = a_y->positive();
+
+        /// As in factor::join, we mustn't traverse
+        ///     to the children of the deeper node.
+        if (a_x->depth() > a_y->depth())
+        {
+            l_x_left = a_x;
+            l_x_right = a_x;
+        }
+        else if (a_y->depth() > a_x->depth())
+        {
+            l_y_left = a_y;
+            l_y_right = a_y;
+        }
+
+        return a_cache[l_key] = global_node_sink<T>::bound()->emplace(
+            std::min(a_x->depth(), a_y->depth()),
+            apply(a_cache, a_operation, l_x_left, l_y_left),
+            apply(a_cache, a_operation, l_x_right, l_y_right)
+        );
+
+    }
+
+    /// Compares every value of the algebraic DAG
+    ///     against a constant, producing the factor
+    ///     DAG of the assignments where it holds. The
+    ///     cache is keyed by the comparison and the
+    ///     constant as well, so it may be shared.
+    template<typename T>
+    inline const factor::node* compare(
+        std::map<std::tuple<const node<T>*, comparison, T>, const factor::node*>& a_cache,
+        const node<T>* a_node,
+        comparison a_comparison,
+        T a_constant
+    )
+    {
+        if (a_node->terminal())
+        {
+            bool l_result = false;
+
+            switch (a_comparison)
+            {
+                case comparison::EQUAL:         { l_result = a_node->value() == a_constant; break; }
+                case comparison::NOT_EQUAL:     { l_result = a_node->value() != a_constant; break; }
+                case comparison::LESS:          { l_result = a_node->value() <  a_constant; break; }
+                case comparison::LESS_EQUAL:    { l_result = a_node->value() <= a_constant; break; }
+                case comparison::GREATER:       { l_result = a_node->value() >  a_constant; break; }
+                case comparison::GREATER_EQUAL: { l_result = a_node->value() >= a_constant; break; }
+            }
+
+            return l_result ? factor::ONE : factor::ZERO;
+
+        }
+
+        std::tuple<const node<T>*, comparison, T> l_key = { a_node, a_comparison, a_constant };
+
+        return CACHE(
+            a_cache,
+            l_key,
+            factor::global_node_sink::bound()->emplace(
+                a_node->depth(),
+                compare(a_cache, a_node->negative(), a_comparison, a_constant),
+                compare(a_cache, a_node->positive(), a_comparison, a_constant)
+            )
+        );
+
+    }
+
+    /// Evaluates the function represented by the
+    ///     algebraic DAG on the argued input.
+    template<typename T>
+    inline T evaluate(
+        const node<T>* a_node,
+        const std::vector<bool>& a_input
+    )
+    {
+        while (!a_node->terminal())
+            a_node = a_input[a_node->depth()] ? a_node->positive() : a_node->negative();
+
+        return a_node->value();
+
+    }
+
+    template<typename T>
+    inline const node<T>* sum(
+        const node<T>* a_x,
+        const node<T>* a_y
+    )
+    {
+        std::map<std::pair<const node<T>*, const node<T>*>, const node<T>*> l_cache;
+        return apply(l_cache, [](T a_a, T a_b) { return a_a + a_b; }, a_x, a_y);
+    }
+
+    template<typename T>
+    inline const node<T>* product(
+        const node<T>* a_x,
+        const node<T>* a_y
+    )
+    {
+        std::map<std::pair<const node<T>*, const node<T>*>, const node<T>*> l_cache;
+        return apply(l_cache, [](T a_a, T a_b) { return a_a * a_b; }, a_x, a_y);
+    }
+
+    template<typename T>
+    inline const node<T>* maximum(
+        const node<T>* a_x,
+        const node<T>* a_y
+    )
+    {
+        std::map<std::pair<const node<T>*, const node<T>*>, const node<T>*> l_cache;
+        return apply(l_cache, [](T a_a, T a_b) { return std::max(a_a, a_b); }, a_x, a_y);
+    }
+
+    template<typename T>
+    inline const node<T>* minimum(
+        const node<T>* a_x,
+        const node<T>* a_y
+    )
+    {
+        std::map<std::pair<const node<T>*, const node<T>*>, const node<T>*> l_cache;
+        return apply(l_cache, [](T a_a, T a_b) { return std::min(a_a, a_b); }, a_x, a_y);
+    }
+
+    /// Constructs the unsigned integer encoded by
+    ///     the argued factor DAGs, least significant
+    ///     bit first, as a single algebraic DAG.
+    template<typename T>
+    inline const node<T>* from_bits(
+        const std::list<const factor::node*>& a_bits
+    )
+    {
+        const node<T>* l_result = constant<T>(0);
+        T l_weight = 1;
+
+        std::map<const factor::node*, const node<T>*> l_cache;
+
+        for (const factor::node* l_bit : a_bits)
+        {
+            l_result = sum(l_result, product(from_dag(l_cache, l_bit), constant<T>(l_weight)));
+            l_weight *= 2;
+        }
+
+        return l_result;
+
+    }
+
+    #pragma endregion
+
+}
+
+#endif
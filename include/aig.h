@@ -0,0 +1,639 @@
+#ifndef AIG_H
+#define AIG_H
+
+#include "factor.h"
+
+/// And-inverter graphs are a structural, non-canonical
+///     circuit representation. Each node is the
+///     conjunction of two edges, and an edge may
+///     complement its target. Structural hashing
+///     shares identical gates, so that a circuit is
+///     cheap to build and is only later converted to
+///     canonical factor DAGs.
+///
+/// An edge is twice the index of its target node,
+///     plus one if complemented. Node zero is the
+///     constant, so edge zero is false and edge one
+///     is true.
+namespace factor::aig
+{
+
+    ////////////////////////////////////////////
+    ////////////// DATA STRUCTURES /////////////
+    ////////////////////////////////////////////
+    #pragma region DATA STRUCTURES
+
+    using edge = uint32_t;
+
+    inline constexpr edge ZERO_EDGE = 0;
+    inline constexpr edge ONE_EDGE = 1;
+
+    inline constexpr uint32_t index(
+        edge a_edge
+    )
+    {
+        return a_edge >> 1;
+    }
+
+    inline constexpr bool complemented(
+        edge a_edge
+    )
+    {
+        return (a_edge & 0x1) != 0;
+    }
+
+    inline constexpr edge invert(
+        edge a_edge
+    )
+    {
+        return a_edge ^ 0x1;
+    }
+
+    class graph
+    {
+    public:
+
+        /// The fanins of the argued node. Inputs,
+        ///     and the constant, have NO_FANIN for both.
+        struct gate
+        {
+            edge m_x;
+            edge m_y;
+        };
+
+        static constexpr edge NO_FANIN = UINT32_MAX;
+
+    private:
+
+        std::vector<gate> m_gates = { { NO_FANIN, NO_FANIN } };
+        std::vector<edge> m_inputs;
+
+        /// Maps the ordered fanins of each
+        ///     conjunction to its node's edge.
+        std::map<std::pair<edge, edge>, edge> m_hash;
+
+    public:
+
+        size_t size(
+
+        ) const
+        {
+            return m_gates.size();
+        }
+
+        const std::vector<edge>& inputs(
+
+        ) const
+        {
+            return m_inputs;
+        }
+
+        const gate& fanins(
+            uint32_t a_index
+        ) const
+        {
+            return m_gates[a_index];
+        }
+
+        bool is_gate(
+            uint32_t a_index
+        ) const
+        {
+            return m_gates[a_index].m_x != NO_FANIN;
+        }
+
+        edge input(
+
+        )
+        {
+            edge l_result = 2 * m_gates.size();
+
+            m_gates.push_back({ NO_FANIN, NO_FANIN });
+            m_inputs.push_back(l_result);
+
+            return l_result;
+
+        }
+
+        edge conjoin(
+            edge a_x,
+            edge a_y
+        )
+        {
+            if (a_x > a_y)
+                std::swap(a_x, a_y);
+
+            /// Propagate constants, and fold repeated
+            ///     or complementary fanins.
+            if (a_x == ZERO_EDGE || a_x == invert(a_y))
+                return ZERO_EDGE;
+            if (a_x == ONE_EDGE || a_x == a_y)
+                return a_y;
+
+            std::pair<edge, edge> l_key = { a_x, a_y };
+
+            auto l_it = m_hash.find(l_key);
+
+            if (l_it != m_hash.end())
+                return l_it->second;
+
+            edge l_result = 2 * m_gates.size();
+
+            m_gates.push_back({ a_x, a_y });
+
+            return m_hash[l_key] = l_result;
+
+        }
+
+        edge disjoin(
+            edge a_x,
+            edge a_y
+        )
+        {
+            return invert(conjoin(invert(a_x), invert(a_y)));
+        }
+
+    };
+
+    /// The value type of the logic:: templates over
+    ///     the bound graph, distinct from the raw edge
+    ///     so that the specializations below apply to
+    ///     no other integer.
+    struct signal
+    {
+        edge m_edge;
+
+        bool operator==(
+            const signal& a_other
+        ) const = default;
+
+    };
+
+    /// The canonical DAGs of the requested outputs,
+    ///     along with the variable assigned to each
+    ///     input, by position.
+    struct conversion
+    {
+        std::vector<const node*> m_outputs;
+        std::vector<uint32_t> m_variables;
+    };
+
+    #pragma endregion
+
+    ////////////////////////////////////////////
+    //////////////// GLOBAL VARS ///////////////
+    ////////////////////////////////////////////
+    #pragma region GLOBAL VARS
+
+    /// The graph in which the logic:: templates
+    ///     build their gates.
+    class global_graph_sink
+    {
+        static inline graph* s_graph = nullptr;
+
+    public:
+        static void bind(
+            graph* a_graph
+        )
+        {
+            s_graph = a_graph;
+        }
+
+        static graph* bound(
+
+        )
+        {
+            return s_graph;
+        }
+
+    };
+
+    #pragma endregion
+
+    ////////////////////////////////////////////
+    //////////////// ALGORITHMS ////////////////
+    ////////////////////////////////////////////
+    #pragma region ALGORITHMS
+
+    /// Numbers the inputs, by position, in the order
+    ///     a depth-first traversal from the outputs
+    ///     first reaches each, which keeps the inputs
+    ///     of each subcircuit close together. Inputs
+    ///     outside every output's cone follow, in
+    ///     position order.
+    inline std::vector<uint32_t> depth_first_order(
+        const graph& a_graph,
+        const std::vector<edge>& a_outputs
+    )
+    {
+        std::vector<uint32_t> l_variables(a_graph.size(), UINT32_MAX);
+        std::vector<bool> l_visited(a_graph.size(), false);
+        std::stack<uint32_t> l_stack;
+
+        uint32_t l_next_variable = 0;
+
+        for (auto l_it = a_outputs.rbegin(); l_it != a_outputs.rend(); l_it++)
+            l_stack.push(index(*l_it));
+
+        while (!l_stack.empty())
+        {
+            uint32_t l_index = l_stack.top();
+            l_stack.pop();
+
+            if (l_visited[l_index])
+                continue;
+
+            l_visited[l_index] = true;
+
+            if (!a_graph.is_gate(l_index))
+            {
+                if (l_index != 0)
+                    l_variables[l_index] = l_next_variable++;
+
+                continue;
+
+            }
+
+            l_stack.push(index(a_graph.fanins(l_index).m_y));
+            l_stack.push(index(a_graph.fanins(l_index).m_x));
+
+        }
+
+        std::vector<uint32_t> l_result;
+
+        for (edge l_input : a_graph.inputs())
+        {
+            if (l_variables[index(l_input)] == UINT32_MAX)
+                l_variables[index(l_input)] = l_next_variable++;
+
+            l_result.push_back(l_variables[index(l_input)]);
+
+        }
+
+        return l_result;
+
+    }
+
+    /// Evaluates the edge by simulating the graph on
+    ///     the argued input values, by input position,
+    ///     without building any DAG.
+    inline bool evaluate(
+        const graph& a_graph,
+        edge a_edge,
+        const std::vector<bool>& a_input
+    )
+    {
+        std::vector<int8_t> l_values(a_graph.size(), -1);
+
+        l_values[0] = 0;
+
+        for (size_t i = 0; i < a_graph.inputs().size(); i++)
+            l_values[index(a_graph.inputs()[i])] = a_input[i];
+
+        std::stack<uint32_t> l_stack;
+
+        l_stack.push(index(a_edge));
+
+        while (!l_stack.empty())
+        {
+            uint32_t l_index = l_stack.top();
+
+            if (l_values[l_index] >= 0)
+            {
+                l_stack.pop();
+                continue;
+            }
+
+            const graph::gate& l_gate = a_graph.fanins(l_index);
+
+            int8_t l_x = l_values[index(l_gate.m_x)];
+            int8_t l_y = l_values[index(l_gate.m_y)];
+
+            if (l_x < 0 || l_y < 0)
+            {
+                if (l_x < 0)
+                    l_stack.push(index(l_gate.m_x));
+                if (l_y < 0)
+                    l_stack.push(index(l_gate.m_y));
+
+                continue;
+
+            }
+
+            l_values[l_index] = (l_x ^ complemented(l_gate.m_x)) & (l_y ^ complemented(l_gate.m_y));
+
+            l_stack.pop();
+
+        }
+
+        return l_values[index(a_edge)] ^ complemented(a_edge);
+
+    }
+
+    /// Converts the argued outputs into the bound dag,
+    ///     numbering the variables in depth-first
+    ///     order. The gates are converted in topological
+    ///     order, and each gate's result is dropped as
+    ///     soon as its last fanout has consumed it. When
+    ///     the caller argues the nodes it retains in the
+    ///     bound dag, the dag is collected whenever it
+    ///     doubles, keeping only those, the undropped
+    ///     results and the nodes beneath them.
+    inline conversion to_dag(
+        const graph& a_graph,
+        const std::vector<edge>& a_outputs,
+        const std::optional<std::vector<const node*>>& a_retained = std::nullopt
+    )
+    {
+        conversion l_result = { {}, depth_first_order(a_graph, a_outputs) };
+
+        /// The gates of the cones, fanins first.
+        std::vector<uint32_t> l_order;
+        std::vector<bool> l_visited(a_graph.size(), false);
+        std::stack<std::pair<uint32_t, bool>> l_stack;
+
+        for (auto l_it = a_outputs.rbegin(); l_it != a_outputs.rend(); l_it++)
+            l_stack.emplace(index(*l_it), false);
+
+        while (!l_stack.empty())
+        {
+            auto [l_index, l_expanded] = l_stack.top();
+            l_stack.pop();
+
+            if (l_expanded)
+            {
+                l_order.push_back(l_index);
+                continue;
+            }
+
+            if (l_visited[l_index] || !a_graph.is_gate(l_index))
+                continue;
+
+            l_visited[l_index] = true;
+
+            l_stack.emplace(l_index, true);
+            l_stack.emplace(index(a_graph.fanins(l_index).m_y), false);
+            l_stack.emplace(index(a_graph.fanins(l_index).m_x), false);
+
+        }
+
+        /// Count the consumers of each node, where each
+        ///     output holds its node until the end.
+        std::vector<uint32_t> l_fanouts(a_graph.size(), 0);
+
+        for (uint32_t l_index : l_order)
+        {
+            l_fanouts[index(a_graph.fanins(l_index).m_x)]++;
+            l_fanouts[index(a_graph.fanins(l_index).m_y)]++;
+        }
+
+        for (edge l_output : a_outputs)
+            l_fanouts[index(l_output)]++;
+
+        std::map<uint32_t, const node*> l_nodes = { { 0, ZERO } };
+
+        for (size_t i = 0; i < a_graph.inputs().size(); i++)
+            l_nodes[index(a_graph.inputs()[i])] = literal(l_result.m_variables[i], true);
+
+        std::map<std::tuple<operation, const node*, const node*>, const node*> l_cache;
+
+        dag* l_dag = global_node_sink::bound();
+
+        /// The size of the dag after the last collection.
+        size_t l_collected = std::max<size_t>(l_dag->size(), 1);
+
+        const auto l_node = [&](edge a_edge)
+        {
+            const node* l_target = l_nodes.at(index(a_edge));
+
+            return complemented(a_edge) ? apply(l_cache, operation::NOT_X, l_target, ZERO) : l_target;
+
+        };
+
+        for (uint32_t l_index : l_order)
+        {
+            const graph::gate& l_gate = a_graph.fanins(l_index);
+
+            l_nodes[l_index] = apply(l_cache, operation::AND, l_node(l_gate.m_x), l_node(l_gate.m_y));
+
+            for (edge l_fanin : { l_gate.m_x, l_gate.m_y })
+                if (--l_fanouts[index(l_fanin)] == 0)
+                    l_nodes.erase(index(l_fanin));
+
+            if (!a_retained || l_dag->size() < 2 * l_collected)
+                continue;
+
+            std::vector<const node*> l_live = *a_retained;
+
+            for (const auto& [l_key, l_value] : l_nodes)
+                l_live.push_back(l_value);
+
+            /// The cache would dangle into the erased nodes.
+            l_dag->collect(l_live);
+            l_cache.clear();
+
+            l_collected = std::max<size_t>(l_dag->size(), 1);
+
+        }
+
+        for (edge l_output : a_outputs)
+            l_result.m_outputs.push_back(l_node(l_output));
+
+        return l_result;
+
+    }
+
+    /// Converts the outputs of a graph into the bound
+    ///     dag lazily, one queried edge at a time, so
+    ///     that only the cones actually compared or
+    ///     counted are ever made canonical. Evaluation
+    ///     needs no DAG at all, see aig::evaluate.
+    ///     Every converted gate is retained, and shared
+    ///     by the cones of later queries.
+    class materializer
+    {
+        const graph& m_graph;
+
+        std::vector<uint32_t> m_variables;
+
+        /// The DAG of each converted node, uncomplemented.
+        std::map<uint32_t, const node*> m_nodes;
+
+        std::map<std::tuple<operation, const node*, const node*>, const node*> m_cache;
+
+    public:
+
+        /// Assigns each input, by position, the
+        ///     argued variable.
+        materializer(
+            const graph& a_graph,
+            const std::vector<uint32_t>& a_variables
+        ) :
+            m_graph(a_graph),
+            m_variables(a_variables),
+            m_nodes({ { 0, ZERO } })
+        {
+            for (size_t i = 0; i < a_graph.inputs().size(); i++)
+                m_nodes[index(a_graph.inputs()[i])] = literal(a_variables[i], true);
+        }
+
+        /// Assigns each input its position as variable.
+        materializer(
+            const graph& a_graph
+        ) :
+            materializer(a_graph, positional(a_graph))
+        {
+
+        }
+
+        const graph& source(
+
+        ) const
+        {
+            return m_graph;
+        }
+
+        const std::vector<uint32_t>& variables(
+
+        ) const
+        {
+            return m_variables;
+        }
+
+        /// The number of nodes converted so far,
+        ///     including the inputs and the constant.
+        size_t size(
+
+        ) const
+        {
+            return m_nodes.size();
+        }
+
+        const node* materialize(
+            edge a_edge
+        )
+        {
+            std::stack<uint32_t> l_stack;
+
+            l_stack.push(index(a_edge));
+
+            while (!l_stack.empty())
+            {
+                uint32_t l_index = l_stack.top();
+
+                if (m_nodes.contains(l_index))
+                {
+                    l_stack.pop();
+                    continue;
+                }
+
+                const graph::gate& l_gate = m_graph.fanins(l_index);
+
+                auto l_x = m_nodes.find(index(l_gate.m_x));
+                auto l_y = m_nodes.find(index(l_gate.m_y));
+
+                if (l_x == m_nodes.end() || l_y == m_nodes.end())
+                {
+                    if (l_x == m_nodes.end())
+                        l_stack.push(index(l_gate.m_x));
+                    if (l_y == m_nodes.end())
+                        l_stack.push(index(l_gate.m_y));
+
+                    continue;
+
+                }
+
+                m_nodes[l_index] = apply(
+                    m_cache,
+                    operation::AND,
+                    polarize(l_x->second, l_gate.m_x),
+                    polarize(l_y->second, l_gate.m_y)
+                );
+
+                l_stack.pop();
+
+            }
+
+            return polarize(m_nodes[index(a_edge)], a_edge);
+
+        }
+
+        bool equivalent(
+            edge a_x,
+            edge a_y
+        )
+        {
+            return materialize(a_x) == materialize(a_y);
+        }
+
+    private:
+
+        static std::vector<uint32_t> positional(
+            const graph& a_graph
+        )
+        {
+            std::vector<uint32_t> l_result(a_graph.inputs().size());
+
+            for (uint32_t i = 0; i < l_result.size(); i++)
+                l_result[i] = i;
+
+            return l_result;
+
+        }
+
+        const node* polarize(
+            const node* a_node,
+            edge a_edge
+        )
+        {
+            return complemented(a_edge) ? apply(m_cache, operation::NOT_X, a_node, ZERO) : a_node;
+        }
+
+    };
+
+    #pragma endregion
+
+}
+
+namespace logic
+{
+
+    ////////////////////////////////////////////
+    //////// USER-SPECIALIZED AIG LOGIC ////////
+    ////////////////////////////////////////////
+    #pragma region USER-SPECIALIZED AIG LOGIC
+
+    template<>
+    inline factor::aig::signal padding(
+        bool a_logic_state
+    )
+    {
+        return { a_logic_state ? factor::aig::ONE_EDGE : factor::aig::ZERO_EDGE };
+    }
+
+    template<>
+    inline factor::aig::signal join(
+        bool a_identity,
+        factor::aig::signal a_x,
+        factor::aig::signal a_y
+    )
+    {
+        factor::aig::graph* l_graph = factor::aig::global_graph_sink::bound();
+
+        return { a_identity ? l_graph->conjoin(a_x.m_edge, a_y.m_edge) : l_graph->disjoin(a_x.m_edge, a_y.m_edge) };
+
+    }
+
+    template<>
+    inline factor::aig::signal invert(
+        factor::aig::signal a_x
+    )
+    {
+        return { factor::aig::invert(a_x.m_edge) };
+    }
+
+    #pragma endregion
+
+}
+
+#endif
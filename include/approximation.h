@@ -0,0 +1,409 @@
+#ifndef APPROXIMATION_H
+#define APPROXIMATION_H
+
+#include <tuple>
+
+#include "factor.h"
+
+/// Each of the approximations below returns a
+///     function which implies the argued one,
+///     built with no more than the argued number
+///     of nodes, trading satisfying assignments
+///     for a bounded DAG size.
+namespace factor
+{
+
+    ////////////////////////////////////////////
+    //////////////// ALGORITHMS ////////////////
+    ////////////////////////////////////////////
+    #pragma region ALGORITHMS
+
+    /// Rebuilds the DAG, with each node in the
+    ///     replacement map substituted by its
+    ///     (likewise rebuilt) replacement.
+    inline const node* remap(
+        std::map<const node*, const node*>& a_cache,
+        const std::map<const node*, const node*>& a_replacements,
+        const node* a_node
+    )
+    {
+        if (a_node == ZERO || a_node == ONE)
+            return a_node;
+
+        forbid_leaves("remap");
+
+        if (a_cache.contains(a_node))
+            return a_cache[a_node];
+
+        auto l_replacement = a_replacements.find(a_node);
+
+        if (l_replacement != a_replacements.end())
+            return a_cache[a_node] = remap(a_cache, a_replacements, l_replacement->second);
+
+        dag* l_dag = global_node_sink::bound();
+
+        return a_cache[a_node] = l_dag->emplace(
+            a_node->depth(),
+            remap(a_cache, a_replacements, l_dag->negative(a_node)),
+            remap(a_cache, a_replacements, l_dag->positive(a_node))
+        );
+
+    }
+
+    /// Heavy-branch subsetting. Descends from the root
+    ///     along the child with more satisfying
+    ///     assignments, discarding the lighter child,
+    ///     until the remaining subgraph plus the path
+    ///     leading to it fit within the threshold.
+    inline const node* subset_heavy_branch(
+        const node* a_node,
+        size_t a_threshold
+    )
+    {
+        forbid_leaves("subset_heavy_branch");
+
+        dag* l_dag = global_node_sink::bound();
+
+        std::map<const node*, double> l_fractions;
+
+        /// The heavy path, as each node's depth and
+        ///     whether its positive child is kept.
+        std::vector<std::pair<uint32_t, bool>> l_path;
+
+        while (a_node != ZERO && a_node != ONE &&
+               l_path.size() + node_count(a_node) > a_threshold)
+        {
+            bool l_positive =
+                fraction(l_fractions, l_dag->positive(a_node)) >=
+                fraction(l_fractions, l_dag->negative(a_node));
+
+            l_path.emplace_back(a_node->depth(), l_positive);
+
+            a_node = l_positive ? l_dag->positive(a_node) : l_dag->negative(a_node);
+
+        }
+
+        /// Even a single path does not fit.
+        if (l_path.size() > a_threshold)
+            return ZERO;
+
+        for (auto l_it = l_path.rbegin(); l_it != l_path.rend(); l_it++)
+            a_node = l_dag->emplace(
+                l_it->first,
+                l_it->second ? ZERO : a_node,
+                l_it->second ? a_node : ZERO
+            );
+
+        return a_node;
+
+    }
+
+    /// Short-path subsetting. Keeps only the nodes
+    ///     lying on the shortest paths to ONE, with
+    ///     the longest path length bound whose nodes
+    ///     fit within the threshold.
+    inline const node* subset_short_paths(
+        const node* a_node,
+        size_t a_threshold
+    )
+    {
+        forbid_chains("subset_short_paths");
+        forbid_leaves("subset_short_paths");
+
+        if (a_node == ZERO || a_node == ONE)
+            return a_node;
+
+        /// Gather the nodes, parents before children.
+        std::vector<const node*> l_nodes;
+        std::set<const node*> l_visited;
+        std::stack<const node*> l_stack;
+
+        l_stack.push(a_node);
+
+        while (!l_stack.empty())
+        {
+            const node* l_node = l_stack.top();
+            l_stack.pop();
+
+            if (l_node == ZERO || l_node == ONE || !l_visited.insert(l_node).second)
+                continue;
+
+            l_nodes.push_back(l_node);
+            l_stack.push(l_node->negative());
+            l_stack.push(l_node->positive());
+
+        }
+
+        std::sort(l_nodes.begin(), l_nodes.end(), [](const node* a_x, const node* a_y)
+        {
+            return a_x->depth() < a_y->depth();
+        });
+
+        constexpr size_t UNREACHABLE = SIZE_MAX / 4;
+
+        std::map<const node*, size_t> l_from_root = { { a_node, 0 } };
+        std::map<const node*, size_t> l_to_one = { { ONE, 0 }, { ZERO, UNREACHABLE } };
+
+        for (const node* l_node : l_nodes)
+            for (const node* l_child : { l_node->negative(), l_node->positive() })
+                if (l_child != ZERO && l_child != ONE &&
+                    (!l_from_root.contains(l_child) || l_from_root[l_child] > l_from_root[l_node] + 1))
+                    l_from_root[l_child] = l_from_root[l_node] + 1;
+
+        for (auto l_it = l_nodes.rbegin(); l_it != l_nodes.rend(); l_it++)
+            l_to_one[*l_it] =
+                std::min(l_to_one[(*l_it)->negative()], l_to_one[(*l_it)->positive()]) + 1;
+
+        /// The length of the shortest path to ONE
+        ///     through each node.
+        std::vector<size_t> l_lengths;
+
+        for (const node* l_node : l_nodes)
+            l_lengths.push_back(l_from_root[l_node] + l_to_one[l_node]);
+
+        std::sort(l_lengths.begin(), l_lengths.end());
+
+        /// Find the longest bound whose nodes all fit.
+        size_t l_bound = 0;
+
+        for (size_t i = 0; i < l_lengths.size() && i < a_threshold; i++)
+            if (i + 1 == l_lengths.size() || l_lengths[i + 1] != l_lengths[i])
+                l_bound = l_lengths[i];
+
+        /// Not even the nodes of the shortest length
+        ///     fit, so keep a single shortest path.
+        if (l_bound == 0)
+        {
+            if (l_to_one[a_node] > a_threshold)
+                return ZERO;
+
+            std::vector<std::pair<uint32_t, bool>> l_path;
+
+            for (const node* l_node = a_node; l_node != ONE;)
+            {
+                bool l_positive = l_to_one[l_node->positive()] <= l_to_one[l_node->negative()];
+
+                l_path.emplace_back(l_node->depth(), l_positive);
+
+                l_node = l_positive ? l_node->positive() : l_node->negative();
+
+            }
+
+            const node* l_result = ONE;
+
+            for (auto l_it = l_path.rbegin(); l_it != l_path.rend(); l_it++)
+                l_result = global_node_sink::bound()->emplace(
+                    l_it->first,
+                    l_it->second ? ZERO : l_result,
+                    l_it->second ? l_result : ZERO
+                );
+
+            return l_result;
+
+        }
+
+        std::map<const node*, const node*> l_replacements;
+
+        for (const node* l_node : l_nodes)
+            if (l_from_root[l_node] + l_to_one[l_node] > l_bound)
+                l_replacements[l_node] = ZERO;
+
+        std::map<const node*, const node*> l_cache;
+
+        return remap(l_cache, l_replacements, a_node);
+
+    }
+
+    /// Remap under-approximation. Repeatedly replaces
+    ///     the nodes whose removal loses the fewest
+    ///     satisfying assignments per node saved, either
+    ///     by ZERO or by a child which implies its sibling.
+    inline const node* subset_remap(
+        const node* a_node,
+        size_t a_threshold
+    )
+    {
+        forbid_chains("subset_remap");
+        forbid_leaves("subset_remap");
+
+        size_t l_node_count = node_count(a_node);
+
+        while (l_node_count > a_threshold)
+        {
+            std::vector<const node*> l_nodes;
+            std::map<const node*, size_t> l_references;
+            std::stack<const node*> l_stack;
+
+            l_stack.push(a_node);
+            l_references[a_node] = 1;
+
+            while (!l_stack.empty())
+            {
+                const node* l_node = l_stack.top();
+                l_stack.pop();
+
+                l_nodes.push_back(l_node);
+
+                for (const node* l_child : { l_node->negative(), l_node->positive() })
+                    if (l_child != ZERO && l_child != ONE && l_references[l_child]++ == 0)
+                        l_stack.push(l_child);
+
+            }
+
+            std::sort(l_nodes.begin(), l_nodes.end(), [](const node* a_x, const node* a_y)
+            {
+                return a_x->depth() < a_y->depth();
+            });
+
+            /// The probability of reaching each node
+            ///     under a uniformly random assignment.
+            std::map<const node*, double> l_reach = { { a_node, 1.0 } };
+
+            for (const node* l_node : l_nodes)
+                for (const node* l_child : { l_node->negative(), l_node->positive() })
+                    l_reach[l_child] += l_reach[l_node] / 2.0;
+
+            /// The nodes only reachable through each node,
+            ///     under-approximating what its removal saves.
+            std::map<const node*, size_t> l_exclusive;
+
+            for (auto l_it = l_nodes.rbegin(); l_it != l_nodes.rend(); l_it++)
+            {
+                size_t& l_count = l_exclusive[*l_it] = 1;
+
+                for (const node* l_child : { (*l_it)->negative(), (*l_it)->positive() })
+                    if (l_child != ZERO && l_child != ONE && l_references[l_child] == 1)
+                        l_count += l_exclusive[l_child];
+
+            }
+
+            std::map<const node*, double> l_fractions;
+            std::set<std::pair<const node*, const node*>> l_implications;
+
+            /// Each candidate is its cost per node saved,
+            ///     the nodes saved, the node, and its
+            ///     replacement.
+            std::vector<std::tuple<double, size_t, const node*, const node*>> l_candidates;
+
+            for (const node* l_node : l_nodes)
+            {
+                double l_fraction = fraction(l_fractions, l_node);
+
+                l_candidates.emplace_back(
+                    l_reach[l_node] * l_fraction / l_exclusive[l_node],
+                    l_exclusive[l_node],
+                    l_node,
+                    ZERO
+                );
+
+                for (bool l_positive : { false, true })
+                {
+                    const node* l_kept = l_positive ? l_node->positive() : l_node->negative();
+                    const node* l_dropped = l_positive ? l_node->negative() : l_node->positive();
+
+                    /// Only a child implying its sibling may
+                    ///     replace the node as a subset.
+                    if (!implies(l_implications, l_kept, l_dropped))
+                        continue;
+
+                    size_t l_saved = 1;
+
+                    if (l_dropped != ZERO && l_dropped != ONE && l_references[l_dropped] == 1)
+                        l_saved += l_exclusive[l_dropped];
+
+                    l_candidates.emplace_back(
+                        l_reach[l_node] * (l_fraction - fraction(l_fractions, l_kept)) / l_saved,
+                        l_saved,
+                        l_node,
+                        l_kept
+                    );
+
+                }
+
+            }
+
+            std::sort(l_candidates.begin(), l_candidates.end());
+
+            /// Select the cheapest candidates until their
+            ///     estimated savings cover the excess.
+            std::map<const node*, const node*> l_replacements;
+            size_t l_saved = 0;
+
+            size_t l_excess = l_node_count - a_threshold;
+
+            for (const auto& [l_cost, l_candidate_saved, l_node, l_replacement] : l_candidates)
+            {
+                if (l_saved >= l_excess)
+                    break;
+
+                /// Candidates saving far more than needed,
+                ///     such as removing the root, are only
+                ///     taken when nothing else was selected.
+                if (l_replacements.contains(l_node) || l_candidate_saved > l_excess)
+                    continue;
+
+                l_replacements[l_node] = l_replacement;
+                l_saved += l_candidate_saved;
+
+            }
+
+            /// Otherwise, take the candidate losing the
+            ///     fewest satisfying assignments overall.
+            if (l_replacements.empty())
+            {
+                auto l_cheapest = std::min_element(
+                    l_candidates.begin(),
+                    l_candidates.end(),
+                    [](const auto& a_x, const auto& a_y)
+                    {
+                        return std::get<0>(a_x) * std::get<1>(a_x) < std::get<0>(a_y) * std::get<1>(a_y);
+                    }
+                );
+
+                l_replacements[std::get<2>(*l_cheapest)] = std::get<3>(*l_cheapest);
+
+            }
+
+            std::map<const node*, const node*> l_cache;
+
+            const node* l_result = remap(l_cache, l_replacements, a_node);
+
+            /// The combined replacements may remove every
+            ///     satisfying assignment, in which case only
+            ///     the cheapest single replacement which
+            ///     keeps some assignment is made.
+            if (l_result == ZERO)
+            {
+                double l_total = fraction(l_fractions, a_node);
+
+                for (const auto& [l_cost, l_candidate_saved, l_node, l_replacement] : l_candidates)
+                {
+                    if (l_cost * l_candidate_saved >= l_total)
+                        continue;
+
+                    l_cache.clear();
+                    l_result = remap(l_cache, { { l_node, l_replacement } }, a_node);
+
+                    break;
+
+                }
+
+            }
+
+            a_node = l_result;
+
+            /// Every replacement removes at least its
+            ///     node, so the loop always terminates.
+            l_node_count = node_count(a_node);
+
+        }
+
+        return a_node;
+
+    }
+
+    #pragma endregion
+
+}
+
+#endif
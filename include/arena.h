@@ -0,0 +1,182 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stdint.h>
+#include <vector>
+#include <memory_resource>
+#include <new>
+#include <sys/mman.h>
+
+namespace factor
+{
+
+    ////////////////////////////////////////////
+    ////////////// DATA STRUCTURES /////////////
+    ////////////////////////////////////////////
+    #pragma region DATA STRUCTURES
+
+    /// A monotonic memory resource carving allocations
+    ///     from large anonymous mappings, backed by
+    ///     huge pages where the system provides them,
+    ///     so that a multi-gigabyte dag spans far fewer
+    ///     TLB entries. Deallocation is a no-op, and all
+    ///     memory is released with the arena, so nodes
+    ///     erased by dag::collect are not reused.
+    class huge_page_arena : public std::pmr::memory_resource
+    {
+        static constexpr size_t HUGE_PAGE_BYTES = size_t(2) << 20;
+
+        size_t m_chunk_bytes;
+
+        /// The mappings, as their start and length.
+        std::vector<std::pair<void*, size_t>> m_mappings;
+
+        uintptr_t m_cursor = 0;
+        uintptr_t m_end = 0;
+
+        /// The number of mappings backed by explicitly
+        ///     reserved huge pages, rather than by
+        ///     transparent huge pages.
+        size_t m_explicit_mappings = 0;
+
+    public:
+
+        /// Maps memory in chunks of at least the
+        ///     argued size, rounded to huge pages.
+        huge_page_arena(
+            size_t a_chunk_bytes = size_t(64) << 20
+        ) :
+            m_chunk_bytes((a_chunk_bytes + HUGE_PAGE_BYTES - 1) / HUGE_PAGE_BYTES * HUGE_PAGE_BYTES)
+        {
+
+        }
+
+        /// The mappings cannot be shared.
+        huge_page_arena(
+            const huge_page_arena&
+        ) = delete;
+
+        huge_page_arena& operator=(
+            const huge_page_arena&
+        ) = delete;
+
+        ~huge_page_arena(
+
+        )
+        {
+            for (const auto& [l_start, l_length] : m_mappings)
+                munmap(l_start, l_length);
+        }
+
+        /// The total memory mapped so far.
+        size_t bytes(
+
+        ) const
+        {
+            size_t l_result = 0;
+
+            for (const auto& [l_start, l_length] : m_mappings)
+                l_result += l_length;
+
+            return l_result;
+
+        }
+
+        size_t explicit_mappings(
+
+        ) const
+        {
+            return m_explicit_mappings;
+        }
+
+    private:
+
+        void* do_allocate(
+            size_t a_bytes,
+            size_t a_alignment
+        ) override
+        {
+            uintptr_t l_aligned = (m_cursor + a_alignment - 1) & ~(uintptr_t(a_alignment) - 1);
+
+            if (m_cursor == 0 || l_aligned + a_bytes > m_end)
+            {
+                map(std::max(m_chunk_bytes, a_bytes + a_alignment));
+                l_aligned = (m_cursor + a_alignment - 1) & ~(uintptr_t(a_alignment) - 1);
+            }
+
+            m_cursor = l_aligned + a_bytes;
+
+            return reinterpret_cast<void*>(l_aligned);
+
+        }
+
+        void do_deallocate(
+            void*,
+            size_t,
+            size_t
+        ) override
+        {
+
+        }
+
+        bool do_is_equal(
+            const std::pmr::memory_resource& a_other
+        ) const noexcept override
+        {
+            return this == &a_other;
+        }
+
+        /// Maps a new chunk, starting the cursor at it.
+        ///     Explicit huge pages are tried first, and
+        ///     otherwise an ordinary mapping, aligned to a
+        ///     huge page boundary, is advised to use
+        ///     transparent huge pages.
+        void map(
+            size_t a_bytes
+        )
+        {
+            size_t l_length = (a_bytes + HUGE_PAGE_BYTES - 1) / HUGE_PAGE_BYTES * HUGE_PAGE_BYTES;
+
+            #ifdef MAP_HUGETLB
+            void* l_start = mmap(nullptr, l_length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+
+            if (l_start != MAP_FAILED)
+            {
+                m_mappings.emplace_back(l_start, l_length);
+                m_explicit_mappings++;
+
+                m_cursor = reinterpret_cast<uintptr_t>(l_start);
+                m_end = m_cursor + l_length;
+
+                return;
+
+            }
+            #endif
+
+            /// Over-map by a huge page, so that the chunk
+            ///     can start on a huge page boundary.
+            size_t l_mapped_length = l_length + HUGE_PAGE_BYTES;
+
+            void* l_mapping = mmap(nullptr, l_mapped_length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+            if (l_mapping == MAP_FAILED)
+                throw std::bad_alloc();
+
+            m_mappings.emplace_back(l_mapping, l_mapped_length);
+
+            m_cursor = (reinterpret_cast<uintptr_t>(l_mapping) + HUGE_PAGE_BYTES - 1) & ~(uintptr_t(HUGE_PAGE_BYTES) - 1);
+            m_end = m_cursor + l_length;
+
+            #ifdef MADV_HUGEPAGE
+            madvise(reinterpret_cast<void*>(m_cursor), l_length, MADV_HUGEPAGE);
+            #endif
+
+        }
+
+    };
+
+    #pragma endregion
+
+}
+
+#endif
@@ -0,0 +1,373 @@
+#ifndef BITVECTOR_H
+#define BITVECTOR_H
+
+#include <array>
+
+#include "factor.h"
+
+namespace factor
+{
+
+    ////////////////////////////////////////////
+    ////////////// DATA STRUCTURES /////////////
+    ////////////////////////////////////////////
+    #pragma region DATA STRUCTURES
+
+    /// Holds the function cache shared by every
+    ///     gate built through the word-level API,
+    ///     so that common subfunctions are only
+    ///     ever applied once.
+    struct operation_cache
+    {
+        std::pmr::map<std::tuple<operation, const node*, const node*>, const node*> m_applications;
+
+        operation_cache(
+
+        )
+        {
+
+        }
+
+        /// Allocates the cache from the argued memory
+        ///     resource, typically that of the dag.
+        operation_cache(
+            std::pmr::memory_resource* a_resource
+        ) :
+            m_applications(a_resource)
+        {
+
+        }
+
+        const node* conjoin(
+            const node* a_x,
+            const node* a_y
+        )
+        {
+            return apply(m_applications, operation::AND, a_x, a_y);
+        }
+
+        const node* disjoin(
+            const node* a_x,
+            const node* a_y
+        )
+        {
+            return apply(m_applications, operation::OR, a_x, a_y);
+        }
+
+        const node* invert(
+            const node* a_x
+        )
+        {
+            return apply(m_applications, operation::NOT_X, a_x, ZERO);
+        }
+
+        const node* exor(
+            const node* a_x,
+            const node* a_y
+        )
+        {
+            return apply(m_applications, operation::XOR, a_x, a_y);
+        }
+
+        /// The carry of a full adder.
+        const node* majority(
+            const node* a_x,
+            const node* a_y,
+            const node* a_z
+        )
+        {
+            /// Fold constant and repeated operands.
+            if (a_x == a_y || a_x == a_z)
+                return a_x;
+            if (a_y == a_z)
+                return a_y;
+            if (a_x == ZERO)
+                return conjoin(a_y, a_z);
+            if (a_x == ONE)
+                return disjoin(a_y, a_z);
+
+            return disjoin(
+                conjoin(a_x, a_y),
+                conjoin(a_z, exor(a_x, a_y))
+            );
+
+        }
+
+    };
+
+    /// A fixed-width word of factor DAGs,
+    ///     least significant bit first.
+    template<size_t WIDTH>
+    class bitvector
+    {
+        std::array<const node*, WIDTH> m_bits;
+
+    public:
+
+        bitvector(
+
+        )
+        {
+            m_bits.fill(ZERO);
+        }
+
+        bitvector(
+            const std::array<const node*, WIDTH>& a_bits
+        ) :
+            m_bits(a_bits)
+        {
+
+        }
+
+        /// Constructs the word whose bits are the
+        ///     consecutive variables starting at the
+        ///     argued index.
+        static bitvector variables(
+            uint32_t a_first_variable_index
+        )
+        {
+            bitvector l_result;
+
+            for (size_t i = 0; i < WIDTH; i++)
+                l_result[i] = literal(a_first_variable_index + i, true);
+
+            return l_result;
+
+        }
+
+        static bitvector constant(
+            uint64_t a_value
+        )
+        {
+            bitvector l_result;
+
+            for (size_t i = 0; i < WIDTH && i < 64; i++)
+                l_result[i] = (a_value >> i) & 0x1 ? ONE : ZERO;
+
+            return l_result;
+
+        }
+
+        constexpr size_t size(
+
+        ) const
+        {
+            return WIDTH;
+        }
+
+        const node*& operator[](
+            size_t a_index
+        )
+        {
+            return m_bits[a_index];
+        }
+
+        const node* operator[](
+            size_t a_index
+        ) const
+        {
+            return m_bits[a_index];
+        }
+
+    };
+
+    #pragma endregion
+
+    ////////////////////////////////////////////
+    //////////////// ALGORITHMS ////////////////
+    ////////////////////////////////////////////
+    #pragma region ALGORITHMS
+
+    /// Ripple-carry addition, modulo 2^WIDTH.
+    template<size_t WIDTH>
+    inline bitvector<WIDTH> sum(
+        operation_cache& a_cache,
+        const bitvector<WIDTH>& a_x,
+        const bitvector<WIDTH>& a_y,
+        const node* a_carry = ZERO
+    )
+    {
+        bitvector<WIDTH> l_result;
+
+        for (size_t i = 0; i < WIDTH; i++)
+        {
+            l_result[i] = a_cache.exor(a_cache.exor(a_x[i], a_y[i]), a_carry);
+
+            /// The final carry is discarded.
+            if (i + 1 < WIDTH)
+                a_carry = a_cache.majority(a_x[i], a_y[i], a_carry);
+
+        }
+
+        return l_result;
+
+    }
+
+    /// Two's complement subtraction, modulo 2^WIDTH.
+    template<size_t WIDTH>
+    inline bitvector<WIDTH> difference(
+        operation_cache& a_cache,
+        const bitvector<WIDTH>& a_x,
+        const bitvector<WIDTH>& a_y
+    )
+    {
+        bitvector<WIDTH> l_complement;
+
+        for (size_t i = 0; i < WIDTH; i++)
+            l_complement[i] = a_cache.invert(a_y[i]);
+
+        return sum(a_cache, a_x, l_complement, ONE);
+
+    }
+
+    /// Full-width multiplication. The partial product
+    ///     rows are accumulated in carry-save form, so
+    ///     that only a single carry-propagating addition
+    ///     is performed at the end. Rows are reduced in
+    ///     order rather than as a Wallace tree, since
+    ///     mixing columns from unrelated rows produces
+    ///     far larger intermediate DAGs.
+    template<size_t X_WIDTH, size_t Y_WIDTH>
+    inline bitvector<X_WIDTH + Y_WIDTH> product(
+        operation_cache& a_cache,
+        const bitvector<X_WIDTH>& a_x,
+        const bitvector<Y_WIDTH>& a_y
+    )
+    {
+        constexpr size_t WIDTH = X_WIDTH + Y_WIDTH;
+
+        bitvector<WIDTH> l_sums;
+        bitvector<WIDTH> l_carries;
+
+        for (size_t j = 0; j < Y_WIDTH; j++)
+        {
+            /// Rows multiplied by a zero bit, e.g. of a
+            ///     constant operand, are skipped entirely.
+            if (a_y[j] == ZERO)
+                continue;
+
+            bitvector<WIDTH> l_row;
+
+            for (size_t i = 0; i < X_WIDTH; i++)
+                l_row[i + j] = a_cache.conjoin(a_x[i], a_y[j]);
+
+            bitvector<WIDTH> l_next_sums;
+            bitvector<WIDTH> l_next_carries;
+
+            for (size_t i = 0; i < WIDTH; i++)
+            {
+                l_next_sums[i] = a_cache.exor(a_cache.exor(l_sums[i], l_carries[i]), l_row[i]);
+
+                if (i + 1 < WIDTH)
+                    l_next_carries[i + 1] = a_cache.majority(l_sums[i], l_carries[i], l_row[i]);
+
+            }
+
+            l_sums = l_next_sums;
+            l_carries = l_next_carries;
+
+        }
+
+        return sum(a_cache, l_sums, l_carries);
+
+    }
+
+    template<size_t WIDTH>
+    inline bitvector<WIDTH> shift_left(
+        const bitvector<WIDTH>& a_x,
+        size_t a_amount
+    )
+    {
+        bitvector<WIDTH> l_result;
+
+        for (size_t i = a_amount; i < WIDTH; i++)
+            l_result[i] = a_x[i - a_amount];
+
+        return l_result;
+
+    }
+
+    template<size_t WIDTH>
+    inline bitvector<WIDTH> shift_right(
+        const bitvector<WIDTH>& a_x,
+        size_t a_amount
+    )
+    {
+        bitvector<WIDTH> l_result;
+
+        for (size_t i = 0; i + a_amount < WIDTH; i++)
+            l_result[i] = a_x[i + a_amount];
+
+        return l_result;
+
+    }
+
+    /// Unsigned comparison x < y.
+    template<size_t WIDTH>
+    inline const node* less(
+        operation_cache& a_cache,
+        const bitvector<WIDTH>& a_x,
+        const bitvector<WIDTH>& a_y
+    )
+    {
+        const node* l_result = ZERO;
+
+        /// From the least significant bit upwards,
+        ///     a differing bit overrides the result.
+        for (size_t i = 0; i < WIDTH; i++)
+        {
+            const node* l_x_bar_y = a_cache.conjoin(a_cache.invert(a_x[i]), a_y[i]);
+            const node* l_equal = a_cache.invert(a_cache.exor(a_x[i], a_y[i]));
+
+            l_result = a_cache.disjoin(l_x_bar_y, a_cache.conjoin(l_equal, l_result));
+
+        }
+
+        return l_result;
+
+    }
+
+    template<size_t WIDTH>
+    inline const node* equal(
+        operation_cache& a_cache,
+        const bitvector<WIDTH>& a_x,
+        const bitvector<WIDTH>& a_y
+    )
+    {
+        const node* l_result = ONE;
+
+        for (size_t i = 0; i < WIDTH; i++)
+            l_result = a_cache.conjoin(l_result, a_cache.invert(a_cache.exor(a_x[i], a_y[i])));
+
+        return l_result;
+
+    }
+
+    template<size_t WIDTH>
+    inline const node* equal(
+        operation_cache& a_cache,
+        const bitvector<WIDTH>& a_x,
+        uint64_t a_constant
+    )
+    {
+        const node* l_result = ONE;
+
+        /// Each bit is matched directly against
+        ///     the constant, with no exor gates.
+        for (size_t i = 0; i < WIDTH; i++)
+        {
+            bool l_bit = i < 64 && ((a_constant >> i) & 0x1);
+
+            l_result = a_cache.conjoin(l_result, l_bit ? a_x[i] : a_cache.invert(a_x[i]));
+
+        }
+
+        return l_result;
+
+    }
+
+    #pragma endregion
+
+}
+
+#endif
@@ -0,0 +1,111 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include <string>
+#include <fstream>
+#include <unordered_map>
+
+#include "factor.h"
+
+namespace factor
+{
+
+    ////////////////////////////////////////////
+    ////////////// DATA STRUCTURES /////////////
+    ////////////////////////////////////////////
+    #pragma region DATA STRUCTURES
+
+    /// Incremental, append-only checkpoints of the
+    ///     named roots of a long build, and of the
+    ///     nodes beneath them. Each save appends only
+    ///     the nodes and roots not yet written, then
+    ///     a commit record, so that its cost follows
+    ///     the growth of the dag since the last save.
+    ///
+    /// Opening an existing checkpoint resumes it,
+    ///     emplacing its nodes into the bound dag and
+    ///     restoring the roots of the last commit. Any
+    ///     records after that commit, such as those of
+    ///     a save interrupted by a crash, are discarded.
+    ///
+    /// Nodes are remembered by address, for as long
+    ///     as the bound dag keeps its generation. A
+    ///     collection between saves may free addresses
+    ///     for reuse, so the next save forgets them
+    ///     and writes the nodes beneath its roots anew.
+    class checkpoint
+    {
+        std::string m_path;
+        std::ofstream m_ofstream;
+
+        /// The identifier of each node written in the
+        ///     dag generation below. ZERO and ONE are
+        ///     identifiers zero and one.
+        std::unordered_map<const node*, uint64_t> m_identifiers;
+        uint64_t m_generation = 0;
+        uint64_t m_next_identifier = 2;
+
+        std::map<std::string, const node*> m_roots;
+        std::map<std::string, uint64_t> m_root_identifiers;
+        uint64_t m_commits = 0;
+
+    public:
+
+        /// Creates the checkpoint file, or resumes an
+        ///     existing one into the bound dag. Throws
+        ///     std::runtime_error for a file which is not
+        ///     a checkpoint.
+        checkpoint(
+            const std::string& a_path
+        );
+
+        /// Records the argued roots, replacing any of
+        ///     the same names, along with every node
+        ///     beneath them not yet written, and commits.
+        ///     Returns once the commit is synced to disk.
+        void save(
+            const std::map<std::string, const node*>& a_roots
+        );
+
+        /// The roots as of the last commit.
+        const std::map<std::string, const node*>& roots(
+
+        ) const
+        {
+            return m_roots;
+        }
+
+        uint64_t commits(
+
+        ) const
+        {
+            return m_commits;
+        }
+
+        /// The number of nodes held in the file.
+        uint64_t node_count(
+
+        ) const
+        {
+            return m_next_identifier - 2;
+        }
+
+    private:
+
+        /// Forgets the nodes written so far, but for
+        ///     the terminals.
+        void forget(
+
+        );
+
+        uint64_t write_node(
+            const node* a_node
+        );
+
+    };
+
+    #pragma endregion
+
+}
+
+#endif
@@ -0,0 +1,232 @@
+#ifndef CODEGEN_H
+#define CODEGEN_H
+
+#include <string>
+#include <ostream>
+
+#include "factor.h"
+
+/// Emits straight-line C++ evaluating fixed factor
+///     DAGs, to be compiled into a service rather than
+///     interpreted. Each emitted function reads the
+///     variables from a packed word, variable v being
+///     bit v, so the DAGs may use at most 64 variables,
+///     and at most 64 roots, root i giving result bit i.
+///     The emitted code depends on <stdint.h> alone.
+namespace factor
+{
+
+    ////////////////////////////////////////////
+    //////////////// ALGORITHMS ////////////////
+    ////////////////////////////////////////////
+    #pragma region ALGORITHMS
+
+    /// Numbers the nodes beneath the roots, children
+    ///     before their parents. Throws for DAGs which
+    ///     do not fit the packed words, and for dags
+    ///     of chain nodes or truth-table leaves.
+    inline std::vector<const node*> codegen_order(
+        const std::vector<const node*>& a_roots,
+        std::map<const node*, size_t>& a_numbers
+    )
+    {
+        forbid_chains("codegen");
+        forbid_leaves("codegen");
+
+        if (a_roots.size() > 64)
+            throw std::runtime_error("codegen supports at most 64 roots");
+
+        std::vector<const node*> l_result;
+
+        const auto l_visit = [&](
+            const auto& a_visit,
+            const node* a_node
+        ) -> void
+        {
+            if (a_node == ZERO || a_node == ONE || a_numbers.contains(a_node))
+                return;
+
+            if (a_node->depth() >= 64)
+                throw std::runtime_error("codegen supports at most 64 variables");
+
+            a_visit(a_visit, a_node->negative());
+            a_visit(a_visit, a_node->positive());
+
+            a_numbers[a_node] = l_result.size();
+            l_result.push_back(a_node);
+
+        };
+
+        for (const node* l_root : a_roots)
+            l_visit(l_visit, l_root);
+
+        return l_result;
+
+    }
+
+    /// Emits uint64_t NAME(uint64_t x) as nested
+    ///     branches, one conditional jump per level
+    ///     visited, following a single path per root.
+    inline void emit_branches(
+        std::ostream& a_ostream,
+        const std::string& a_name,
+        const std::vector<const node*>& a_roots
+    )
+    {
+        std::map<const node*, size_t> l_numbers;
+
+        std::vector<const node*> l_nodes = codegen_order(a_roots, l_numbers);
+
+        a_ostream << "inline uint64_t " << a_name << "(uint64_t x)\n{\n    uint64_t r = 0;\n";
+
+        /// Each root descends its own copy of the
+        ///     shared nodes, to reach its own label.
+        for (size_t i = 0; i < a_roots.size(); i++)
+        {
+            std::string l_prefix = "r" + std::to_string(i) + "_";
+
+            const auto l_target = [&](const node* a_node)
+            {
+                return
+                    a_node == ZERO ? l_prefix + "zero" :
+                    a_node == ONE ? l_prefix + "one" :
+                    l_prefix + "n" + std::to_string(l_numbers[a_node]);
+            };
+
+            a_ostream << "    goto " << l_target(a_roots[i]) << ";\n";
+
+            std::set<const node*> l_reachable;
+
+            const auto l_reach = [&](
+                const auto& a_reach,
+                const node* a_node
+            ) -> void
+            {
+                if (a_node == ZERO || a_node == ONE || !l_reachable.insert(a_node).second)
+                    return;
+
+                a_reach(a_reach, a_node->negative());
+                a_reach(a_reach, a_node->positive());
+
+            };
+
+            l_reach(l_reach, a_roots[i]);
+
+            /// Parents first, so that the jumps run
+            ///     forwards, in depth order.
+            for (auto l_it = l_nodes.rbegin(); l_it != l_nodes.rend(); l_it++)
+            {
+                if (!l_reachable.contains(*l_it))
+                    continue;
+
+                a_ostream
+                    << l_target(*l_it) << ":\n"
+                    << "    if ((x >> " << (*l_it)->depth() << ") & 1) goto " << l_target((*l_it)->positive())
+                    << "; else goto " << l_target((*l_it)->negative()) << ";\n";
+
+            }
+
+            a_ostream
+                << l_prefix << "one:\n"
+                << "    r |= uint64_t(1) << " << i << ";\n"
+                << l_prefix << "zero:\n";
+
+        }
+
+        a_ostream << "    return r;\n}\n";
+
+    }
+
+    /// Emits the body shared by the mux and lane
+    ///     variants, where each node selects between
+    ///     its children's words by the mask of its
+    ///     variable, without any branch. Returns the
+    ///     expression of each root's word.
+    inline std::vector<std::string> emit_selections(
+        std::ostream& a_ostream,
+        const std::vector<const node*>& a_roots,
+        const std::string& a_mask_prefix,
+        const std::string& a_mask_suffix
+    )
+    {
+        std::map<const node*, size_t> l_numbers;
+
+        std::vector<const node*> l_nodes = codegen_order(a_roots, l_numbers);
+
+        const auto l_value = [&](const node* a_node)
+        {
+            return
+                a_node == ZERO ? std::string("uint64_t(0)") :
+                a_node == ONE ? std::string("~uint64_t(0)") :
+                "n" + std::to_string(l_numbers[a_node]);
+        };
+
+        for (const node* l_node : l_nodes)
+        {
+            std::string l_mask = a_mask_prefix + std::to_string(l_node->depth()) + a_mask_suffix;
+
+            a_ostream
+                << "    const uint64_t " << l_value(l_node) << " = ("
+                << l_mask << " & " << l_value(l_node->positive()) << ") | (~"
+                << l_mask << " & " << l_value(l_node->negative()) << ");\n";
+
+        }
+
+        std::vector<std::string> l_result;
+
+        for (const node* l_root : a_roots)
+            l_result.push_back(l_value(l_root));
+
+        return l_result;
+
+    }
+
+    /// Emits uint64_t NAME(uint64_t x) as branch-free
+    ///     mux expressions over every node, shared by
+    ///     all roots, in constant time.
+    inline void emit_mux(
+        std::ostream& a_ostream,
+        const std::string& a_name,
+        const std::vector<const node*>& a_roots
+    )
+    {
+        a_ostream << "inline uint64_t " << a_name << "(uint64_t x)\n{\n";
+
+        std::vector<std::string> l_roots =
+            emit_selections(a_ostream, a_roots, "(uint64_t(0) - ((x >> ", ") & 1))");
+
+        a_ostream << "    return uint64_t(0)";
+
+        for (size_t i = 0; i < l_roots.size(); i++)
+            a_ostream << "\n        | ((" << l_roots[i] << " & 1) << " << i << ")";
+
+        a_ostream << ";\n}\n";
+
+    }
+
+    /// Emits void NAME(const uint64_t* x, uint64_t* r),
+    ///     evaluating 64 inputs at once. Word x[v] holds
+    ///     variable v of each lane, and word r[i] receives
+    ///     root i of each lane.
+    inline void emit_lanes(
+        std::ostream& a_ostream,
+        const std::string& a_name,
+        const std::vector<const node*>& a_roots
+    )
+    {
+        a_ostream << "inline void " << a_name << "(const uint64_t* x, uint64_t* r)\n{\n";
+
+        std::vector<std::string> l_roots = emit_selections(a_ostream, a_roots, "x[", "]");
+
+        for (size_t i = 0; i < l_roots.size(); i++)
+            a_ostream << "    r[" << i << "] = " << l_roots[i] << ";\n";
+
+        a_ostream << "}\n";
+
+    }
+
+    #pragma endregion
+
+}
+
+#endif
@@ -0,0 +1,175 @@
+#ifndef CONSTRAINT_H
+#define CONSTRAINT_H
+
+#include "factor.h"
+
+/// Builders of linear constraints over the variables,
+///     emitted bottom-up through dag::emplace alone, so
+///     that no intermediate DAG is ever joined. Each
+///     node is identified by the position among the
+///     sorted variables and the interval of partial
+///     sums known to reach it, as in the construction
+///     of Abio et al., so that a build visits each node
+///     a bounded number of times, even when the weights
+///     make every partial sum distinct. The positions
+///     where every completion agrees collapse to a
+///     terminal, leaving O(n k) nodes for cardinality
+///     constraints.
+namespace factor
+{
+
+    ////////////////////////////////////////////
+    //////////////// ALGORITHMS ////////////////
+    ////////////////////////////////////////////
+    #pragma region ALGORITHMS
+
+    /// Constructs the pseudo-Boolean constraint
+    ///     a_lower <= sum of w_i x_i <= a_upper, over
+    ///     the argued variables and integer weights.
+    inline const node* linear(
+        const std::map<uint32_t, int64_t>& a_weights,
+        int64_t a_lower,
+        int64_t a_upper
+    )
+    {
+        std::vector<std::pair<uint32_t, int64_t>> l_terms(a_weights.begin(), a_weights.end());
+
+        /// The least and greatest sums attainable
+        ///     from each position onwards.
+        std::vector<int64_t> l_minimum(l_terms.size() + 1, 0);
+        std::vector<int64_t> l_maximum(l_terms.size() + 1, 0);
+
+        for (size_t i = l_terms.size(); i-- > 0;)
+        {
+            l_minimum[i] = l_minimum[i + 1] + std::min<int64_t>(l_terms[i].second, 0);
+            l_maximum[i] = l_maximum[i + 1] + std::max<int64_t>(l_terms[i].second, 0);
+        }
+
+        /// The sums are unbounded beyond the sentinels,
+        ///     which are kept when an interval shifts.
+        const auto l_shift = [](int64_t a_bound, int64_t a_weight)
+        {
+            return a_bound == INT64_MIN || a_bound == INT64_MAX ? a_bound : a_bound - a_weight;
+        };
+
+        /// The disjoint intervals of partial sums at each
+        ///     position, keyed by their lower end, with
+        ///     their upper end and the node they reach.
+        std::vector<std::map<int64_t, std::pair<int64_t, const node*>>> l_intervals(l_terms.size());
+
+        /// Returns the node for the partial sum, and an
+        ///     interval of the sums which all reach it.
+        const auto l_build = [&](
+            const auto& a_build,
+            size_t a_position,
+            int64_t a_sum
+        ) -> std::tuple<const node*, int64_t, int64_t>
+        {
+            int64_t l_low = l_minimum[a_position];
+            int64_t l_high = l_maximum[a_position];
+
+            /// Every completion satisfies the constraint.
+            if (a_sum + l_low >= a_lower && a_sum + l_high <= a_upper)
+                return { ONE, a_lower - l_low, a_upper - l_high };
+
+            /// No completion does.
+            if (a_sum + l_high < a_lower)
+                return { ZERO, INT64_MIN, a_lower - l_high - 1 };
+            if (a_sum + l_low > a_upper)
+                return { ZERO, a_upper - l_low + 1, INT64_MAX };
+
+            std::map<int64_t, std::pair<int64_t, const node*>>& l_known = l_intervals[a_position];
+
+            auto l_it = l_known.upper_bound(a_sum);
+
+            if (l_it != l_known.begin() && std::prev(l_it)->second.first >= a_sum)
+                return { std::prev(l_it)->second.second, std::prev(l_it)->first, std::prev(l_it)->second.first };
+
+            const auto& [l_variable, l_weight] = l_terms[a_position];
+
+            auto [l_negative, l_negative_low, l_negative_high] = a_build(a_build, a_position + 1, a_sum);
+            auto [l_positive, l_positive_low, l_positive_high] = a_build(a_build, a_position + 1, a_sum + l_weight);
+
+            /// The sums for which both children are
+            ///     reached from their own intervals.
+            int64_t l_first = std::max(l_negative_low, l_shift(l_positive_low, l_weight));
+            int64_t l_last = std::min(l_negative_high, l_shift(l_positive_high, l_weight));
+
+            const node* l_result = global_node_sink::bound()->emplace(l_variable, l_negative, l_positive);
+
+            /// Overlapping intervals reach the same
+            ///     function, so they merge into one.
+            for (l_it = l_known.upper_bound(l_last); l_it != l_known.begin() && std::prev(l_it)->second.first >= l_first;)
+            {
+                l_it = std::prev(l_it);
+
+                l_first = std::min(l_first, l_it->first);
+                l_last = std::max(l_last, l_it->second.first);
+
+                l_it = l_known.erase(l_it);
+
+            }
+
+            l_known[l_first] = { l_last, l_result };
+
+            return { l_result, l_first, l_last };
+
+        };
+
+        return std::get<0>(l_build(l_build, 0, 0));
+
+    }
+
+    /// The weighted threshold sum of w_i x_i >= a_bound.
+    inline const node* threshold(
+        const std::map<uint32_t, int64_t>& a_weights,
+        int64_t a_bound
+    )
+    {
+        return linear(a_weights, a_bound, INT64_MAX / 2);
+    }
+
+    /// Assigns each of the variables a unit weight,
+    ///     so that a repeated variable counts twice.
+    inline std::map<uint32_t, int64_t> unit_weights(
+        const std::vector<uint32_t>& a_variables
+    )
+    {
+        std::map<uint32_t, int64_t> l_result;
+
+        for (uint32_t l_variable : a_variables)
+            l_result[l_variable]++;
+
+        return l_result;
+
+    }
+
+    inline const node* at_most(
+        const std::vector<uint32_t>& a_variables,
+        int64_t a_count
+    )
+    {
+        return linear(unit_weights(a_variables), INT64_MIN / 2, a_count);
+    }
+
+    inline const node* at_least(
+        const std::vector<uint32_t>& a_variables,
+        int64_t a_count
+    )
+    {
+        return linear(unit_weights(a_variables), a_count, INT64_MAX / 2);
+    }
+
+    inline const node* exactly(
+        const std::vector<uint32_t>& a_variables,
+        int64_t a_count
+    )
+    {
+        return linear(unit_weights(a_variables), a_count, a_count);
+    }
+
+    #pragma endregion
+
+}
+
+#endif
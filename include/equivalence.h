@@ -0,0 +1,229 @@
+#ifndef EQUIVALENCE_H
+#define EQUIVALENCE_H
+
+#include <bit>
+#include <random>
+
+#include "aig.h"
+
+/// Equivalence checking of AIG edges which tries to
+///     falsify first. Random patterns are simulated
+///     64 at a time, one per bit of a word, which
+///     separates differing functions almost always
+///     and at a fraction of the cost of building
+///     their DAGs. Only the pairs surviving simulation
+///     are materialized, under a budget, and compared.
+namespace factor::aig
+{
+
+    ////////////////////////////////////////////
+    ////////////// DATA STRUCTURES /////////////
+    ////////////////////////////////////////////
+    #pragma region DATA STRUCTURES
+
+    struct equivalence
+    {
+        enum class verdict
+        {
+            EQUIVALENT,
+            DIFFERENT,
+            /// The budget was exceeded before the
+            ///     DAGs could be compared.
+            UNKNOWN,
+        };
+
+        verdict m_verdict;
+
+        /// When DIFFERENT, the input values, by
+        ///     position, on which the edges differ.
+        std::vector<bool> m_counterexample;
+
+    };
+
+    #pragma endregion
+
+    ////////////////////////////////////////////
+    //////////////// ALGORITHMS ////////////////
+    ////////////////////////////////////////////
+    #pragma region ALGORITHMS
+
+    /// Simulates 64 patterns at once, given one word of
+    ///     values per input position, returning the
+    ///     word of every node up to the argued index.
+    ///     Every gate's fanins precede it, as the graph
+    ///     only hashes gates over existing edges, so
+    ///     one pass in index order suffices.
+    inline std::vector<uint64_t> simulate(
+        const graph& a_graph,
+        const std::vector<uint64_t>& a_input,
+        uint32_t a_last_index
+    )
+    {
+        std::vector<uint64_t> l_words(a_last_index + 1, 0);
+
+        for (size_t i = 0; i < a_graph.inputs().size(); i++)
+            if (index(a_graph.inputs()[i]) <= a_last_index)
+                l_words[index(a_graph.inputs()[i])] = a_input[i];
+
+        const auto l_word = [&](edge a_edge)
+        {
+            return complemented(a_edge) ? ~l_words[index(a_edge)] : l_words[index(a_edge)];
+        };
+
+        for (uint32_t i = 1; i <= a_last_index; i++)
+            if (a_graph.is_gate(i))
+                l_words[i] = l_word(a_graph.fanins(i).m_x) & l_word(a_graph.fanins(i).m_y);
+
+        return l_words;
+
+    }
+
+    /// Decides whether the two edges are equivalent.
+    ///     The argued rounds of 64 random patterns are
+    ///     simulated first, and only if none differs
+    ///     are both edges materialized, within the
+    ///     tighter of the argued budget and that of
+    ///     the bound dag. The
+    ///     materializer's converted gates and cache are
+    ///     shared across calls, so that checking many
+    ///     pairs of one circuit converts each gate once.
+    inline equivalence check_equivalence(
+        materializer& a_materializer,
+        edge a_x,
+        edge a_y,
+        size_t a_rounds = 16,
+        const budget& a_budget = {},
+        uint64_t a_seed = 0
+    )
+    {
+        const graph& l_graph = a_materializer.source();
+
+        std::mt19937_64 l_random(a_seed);
+
+        uint32_t l_last_index = std::max(index(a_x), index(a_y));
+
+        for (size_t l_round = 0; l_round < a_rounds; l_round++)
+        {
+            std::vector<uint64_t> l_input(l_graph.inputs().size());
+
+            for (uint64_t& l_word : l_input)
+                l_word = l_random();
+
+            std::vector<uint64_t> l_words = simulate(l_graph, l_input, l_last_index);
+
+            uint64_t l_difference =
+                l_words[index(a_x)] ^ l_words[index(a_y)] ^
+                (complemented(a_x) != complemented(a_y) ? UINT64_MAX : 0);
+
+            if (l_difference == 0)
+                continue;
+
+            int l_lane = std::countr_zero(l_difference);
+
+            equivalence l_result = { equivalence::verdict::DIFFERENT, {} };
+
+            for (uint64_t l_word : l_input)
+                l_result.m_counterexample.push_back((l_word >> l_lane) & 0x1);
+
+            return l_result;
+
+        }
+
+        dag* l_dag = global_node_sink::bound();
+
+        budget l_limits = l_dag->limits();
+
+        /// The argued budget only tightens the dag's
+        ///     own, field by field, and neither change
+        ///     of limits rearms the pressure callback.
+        budget l_tightened = l_limits;
+
+        l_tightened.m_node_limit = std::min(l_limits.m_node_limit, a_budget.m_node_limit);
+        l_tightened.m_byte_limit = std::min(l_limits.m_byte_limit, a_budget.m_byte_limit);
+        l_tightened.m_deadline = std::min(l_limits.m_deadline, a_budget.m_deadline);
+
+        if (a_budget.m_pressure_node_count < l_limits.m_pressure_node_count)
+        {
+            l_tightened.m_pressure_node_count = a_budget.m_pressure_node_count;
+            l_tightened.m_pressure = a_budget.m_pressure;
+        }
+
+        const node* l_x;
+        const node* l_y;
+
+        try
+        {
+            l_dag->limit(l_tightened, false);
+
+            l_x = a_materializer.materialize(a_x);
+            l_y = a_materializer.materialize(a_y);
+
+            l_dag->limit(l_limits, false);
+
+        }
+        catch (const budget_exceeded&)
+        {
+            l_dag->limit(l_limits, false);
+            return { equivalence::verdict::UNKNOWN, {} };
+        }
+        catch (...)
+        {
+            l_dag->limit(l_limits, false);
+            throw;
+        }
+
+        if (l_x == l_y)
+            return { equivalence::verdict::EQUIVALENT, {} };
+
+        /// Descend both canonical DAGs together, always
+        ///     into a pair of cofactors which still differ.
+        std::map<uint32_t, bool> l_assignment;
+
+        const auto l_depth = [](const node* a_node)
+        {
+            return a_node == ZERO || a_node == ONE || a_node->is_leaf() ? UINT32_MAX : a_node->depth();
+        };
+
+        while (l_x != l_y && (l_depth(l_x) != UINT32_MAX || l_depth(l_y) != UINT32_MAX))
+        {
+            uint32_t l_variable = std::min(l_depth(l_x), l_depth(l_y));
+
+            const node* l_x_negative = l_depth(l_x) == l_variable ? l_dag->negative(l_x) : l_x;
+            const node* l_x_positive = l_depth(l_x) == l_variable ? l_dag->positive(l_x) : l_x;
+            const node* l_y_negative = l_depth(l_y) == l_variable ? l_dag->negative(l_y) : l_y;
+            const node* l_y_positive = l_depth(l_y) == l_variable ? l_dag->positive(l_y) : l_y;
+
+            bool l_value = l_x_negative == l_y_negative;
+
+            l_assignment[l_variable] = l_value;
+
+            l_x = l_value ? l_x_positive : l_x_negative;
+            l_y = l_value ? l_y_positive : l_y_negative;
+
+        }
+
+        /// Within the leaf region, the tables differ on
+        ///     some row, which assigns the region.
+        if (l_x != l_y)
+        {
+            int l_row = std::countr_zero(l_dag->table(l_x) ^ l_dag->table(l_y));
+
+            for (uint32_t i = 0; i < l_dag->leaf_width(); i++)
+                l_assignment[l_dag->leaf_depth() + i] = ((l_row >> i) & 0x1) != 0;
+
+        }
+
+        equivalence l_result = { equivalence::verdict::DIFFERENT, {} };
+
+        for (uint32_t l_variable : a_materializer.variables())
+            l_result.m_counterexample.push_back(l_assignment.contains(l_variable) && l_assignment[l_variable]);
+
+        return l_result;
+
+    }
+
+    #pragma endregion
+
+}
+
+#endif
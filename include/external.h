@@ -0,0 +1,206 @@
+#ifndef EXTERNAL_H
+#define EXTERNAL_H
+
+#include <string>
+#include <fstream>
+
+#include "factor.h"
+
+/// External-memory DAGs live on local disk as one
+///     stream of node records per depth, so that
+///     their size is bounded by the disk rather than
+///     by RAM. Each operation reads its operands one
+///     depth at a time, strictly in depth order, and
+///     defers the work on deeper nodes through
+///     priority queues, in the style of Adiar.
+///
+/// A node is identified by its depth in the upper and
+///     its index within the depth in the lower 32 bits.
+///     The terminals carry the top bit, which orders
+///     them after every node.
+namespace factor::external
+{
+
+    ////////////////////////////////////////////
+    ////////////// DATA STRUCTURES /////////////
+    ////////////////////////////////////////////
+    #pragma region DATA STRUCTURES
+
+    inline constexpr uint64_t TERMINAL_FLAG = uint64_t(1) << 63;
+    inline constexpr uint64_t ZERO_UID = TERMINAL_FLAG | 0;
+    inline constexpr uint64_t ONE_UID = TERMINAL_FLAG | 1;
+
+    inline constexpr uint64_t make_uid(
+        uint32_t a_depth,
+        uint32_t a_index
+    )
+    {
+        return (uint64_t(a_depth) << 32) | a_index;
+    }
+
+    inline constexpr bool is_terminal(
+        uint64_t a_uid
+    )
+    {
+        return (a_uid & TERMINAL_FLAG) != 0;
+    }
+
+    /// The terminals lie deeper than any node.
+    inline constexpr uint32_t depth_of(
+        uint64_t a_uid
+    )
+    {
+        return is_terminal(a_uid) ? UINT32_MAX : uint32_t(a_uid >> 32);
+    }
+
+    inline constexpr uint32_t index_of(
+        uint64_t a_uid
+    )
+    {
+        return uint32_t(a_uid);
+    }
+
+    struct record
+    {
+        uint64_t m_uid;
+        uint64_t m_negative;
+        uint64_t m_positive;
+    };
+
+    /// The file begins with a header holding the root
+    ///     and the location of the level table, which
+    ///     follows the records and lists, for each depth
+    ///     in increasing order, where its records lie.
+    struct level
+    {
+        uint32_t m_depth;
+        uint64_t m_count;
+        uint64_t m_offset;
+    };
+
+    /// A read-only handle on a DAG stored on disk.
+    class diagram
+    {
+        std::string m_path;
+        uint64_t m_root;
+        std::vector<level> m_levels;
+
+    public:
+
+        /// Reads the header and level table. Throws
+        ///     std::runtime_error for a missing or
+        ///     malformed file.
+        diagram(
+            const std::string& a_path
+        );
+
+        const std::string& path(
+
+        ) const
+        {
+            return m_path;
+        }
+
+        uint64_t root(
+
+        ) const
+        {
+            return m_root;
+        }
+
+        const std::vector<level>& levels(
+
+        ) const
+        {
+            return m_levels;
+        }
+
+        /// Reads the records of the argued level,
+        ///     which are sorted by their uid.
+        std::vector<record> read_level(
+            size_t a_level_index
+        ) const;
+
+    };
+
+    /// Writes a DAG file one level at a time, in
+    ///     any order of depth, and completes it with
+    ///     the root and the level table.
+    class writer
+    {
+        std::ofstream m_ofstream;
+        std::vector<level> m_levels;
+
+    public:
+
+        writer(
+            const std::string& a_path
+        );
+
+        void write_level(
+            uint32_t a_depth,
+            const std::vector<record>& a_records
+        );
+
+        void finish(
+            uint64_t a_root
+        );
+
+    };
+
+    #pragma endregion
+
+    ////////////////////////////////////////////
+    //////////////// ALGORITHMS ////////////////
+    ////////////////////////////////////////////
+    #pragma region ALGORITHMS
+
+    /// Stores the in-memory DAG to the argued path.
+    void from_dag(
+        const node* a_node,
+        const std::string& a_path
+    );
+
+    /// Loads the stored DAG into the bound dag.
+    const node* to_dag(
+        const std::string& a_path
+    );
+
+    /// Swaps the terminals in a single scan. Like
+    ///     apply and restrict, throws if the output
+    ///     path names an input.
+    void invert(
+        const std::string& a_input_path,
+        const std::string& a_output_path
+    );
+
+    /// Applies any of the sixteen binary operations,
+    ///     by a top-down sweep of both operands
+    ///     followed by a bottom-up reduction.
+    void apply(
+        operation a_operation,
+        const std::string& a_x_path,
+        const std::string& a_y_path,
+        const std::string& a_output_path
+    );
+
+    /// Fixes the assigned variables, by the same
+    ///     top-down sweep and bottom-up reduction.
+    void restrict(
+        const std::string& a_input_path,
+        const std::map<uint32_t, bool>& a_assignment,
+        const std::string& a_output_path
+    );
+
+    /// Counts the satisfying assignments over the
+    ///     argued number of variables, in one scan.
+    double sat_count(
+        const std::string& a_path,
+        uint32_t a_variable_count
+    );
+
+    #pragma endregion
+
+}
+
+#endif
@@ -2,7 +2,10 @@
 #define FACTOR_H
 
 #include <stdint.h>
+#include <bit>
 #include <utility>
+#include <tuple>
+#include <optional>
 #include <vector>
 #include <map>
 #include <set>
@@ -11,8 +14,13 @@
 #include <istream>
 #include <functional>
 #include <stack>
+#include <chrono>
+#include <stdexcept>
+#include <cmath>
+#include <memory_resource>
 
 #include "../digital-logic/include/logic.h"
+#include "trace.h"
 
 /// This macro function defines
 ///     getting a value from cache if key contained,
@@ -33,23 +41,64 @@ namespace factor
         /// Defines the depth of the factor in the tree.
         uint32_t m_depth;
 
+        /// Occupies the padding after the depth. Nonzero
+        ///     only for chain nodes, holding the length
+        ///     in bits 0 to 4, the terminal taken off the
+        ///     chain in bit 5, and the value each chained
+        ///     variable must take, first variable lowest,
+        ///     from bit 6 upwards.
+        uint32_t m_chain;
+
         /// Defines the subtrees.
         const node* m_negative;
         const node* m_positive;
 
     public:
 
+        /// Marks the depth of a truth-table leaf, which
+        ///     stores a function of the dag's leaf region
+        ///     as a table in place of its subgraph. The
+        ///     table is held in the negative child and the
+        ///     width of the region in the positive child,
+        ///     and the depth holds the region's first depth.
+        ///     The flag orders leaves after every node.
+        static constexpr uint32_t LEAF_FLAG = 0x80000000;
+
+        /// A chain node stands for a run of nodes, from
+        ///     its depth onwards, each of which has a
+        ///     terminal child, the same for the whole run,
+        ///     and continues at the next depth along its
+        ///     other child. The run ends in an ordinary
+        ///     split, at the depth after the run, between
+        ///     the negative and positive children.
+        static constexpr uint32_t MAX_CHAIN_LENGTH = 26;
+
         node(
             uint32_t a_depth,
             const node* a_left_child,
-            const node* a_right_child
+            const node* a_right_child,
+            uint32_t a_chain = 0
         ) :
             m_depth(a_depth),
+            m_chain(a_chain),
             m_negative(a_left_child),
             m_positive(a_right_child)
         {
 
         }
+
+        static constexpr uint32_t chain(
+            uint32_t a_length,
+            uint32_t a_mask,
+            bool a_off_chain_terminal
+        )
+        {
+            if (a_length == 0)
+                return 0;
+
+            return a_length | (uint32_t(a_off_chain_terminal) << 5) | (a_mask << 6);
+
+        }
         
         uint32_t depth(
 
@@ -72,6 +121,72 @@ namespace factor
             return m_positive;
         }
 
+        /// The number of chained depths before the
+        ///     split, zero for an ordinary node.
+        uint32_t chain_length(
+
+        ) const
+        {
+            return m_chain & 0x1f;
+        }
+
+        /// Bit i holds the value the variable at depth
+        ///     depth() + i must take to stay on the chain.
+        uint32_t chain_mask(
+
+        ) const
+        {
+            return m_chain >> 6;
+        }
+
+        /// The terminal taken off the chain.
+        const node* chain_terminal(
+
+        ) const
+        {
+            return (m_chain & 0x20) != 0 ? reinterpret_cast<const node*>(-1) : nullptr;
+        }
+
+        /// The chain of the continuation, one depth on.
+        uint32_t chain_tail(
+
+        ) const
+        {
+            return chain(chain_length() - 1, chain_mask() >> 1, (m_chain & 0x20) != 0);
+        }
+
+        bool is_leaf(
+
+        ) const
+        {
+            return (m_depth & LEAF_FLAG) != 0;
+        }
+
+        /// The truth table of a leaf, in which bit b
+        ///     holds the value for the assignment giving
+        ///     variable leaf_depth() + i the value of
+        ///     bit i of b.
+        uint64_t table(
+
+        ) const
+        {
+            return reinterpret_cast<uint64_t>(m_negative);
+        }
+
+        uint32_t leaf_depth(
+
+        ) const
+        {
+            return m_depth & ~LEAF_FLAG;
+        }
+
+        uint32_t leaf_width(
+
+        ) const
+        {
+            return (uint32_t)reinterpret_cast<uintptr_t>(m_positive);
+        }
+
         bool operator<(
             const node& a_other
         ) const
@@ -85,6 +200,9 @@ namespace factor
             if (m_positive != a_other.m_positive)
                 return m_positive < a_other.m_positive;
 
+            if (m_chain != a_other.m_chain)
+                return m_chain < a_other.m_chain;
+
             return false;
             
         }
@@ -105,6 +223,140 @@ namespace factor
     inline const node* ONE = reinterpret_cast<const node*>(-1);
     inline const node* ZERO = reinterpret_cast<const node*>(0);
 
+    /// The binary operations of factor::apply, each
+    ///     encoded as its truth table, where bit
+    ///     (2x + y) holds the result for operands x, y.
+    enum class operation : uint8_t
+    {
+        CONTRADICTION           = 0b0000,
+        NOR                     = 0b0001,
+        CONVERSE_NONIMPLICATION = 0b0010,
+        NOT_X                   = 0b0011,
+        NONIMPLICATION          = 0b0100,
+        NOT_Y                   = 0b0101,
+        XOR                     = 0b0110,
+        NAND                    = 0b0111,
+        AND                     = 0b1000,
+        XNOR                    = 0b1001,
+        Y                       = 0b1010,
+        IMPLICATION             = 0b1011,
+        X                       = 0b1100,
+        CONVERSE_IMPLICATION    = 0b1101,
+        OR                      = 0b1110,
+        TAUTOLOGY               = 0b1111,
+    };
+
+    /// Selects how logic::join traverses its
+    ///     operands. The breadth-first engine handles
+    ///     every request of one depth together, which
+    ///     keeps memory accesses local once the dag
+    ///     outgrows the processor caches.
+    enum class join_engine
+    {
+        DEPTH_FIRST,
+        BREADTH_FIRST,
+    };
+
+    /// The order in which dag compaction lays out
+    ///     the surviving nodes. Both emplace children
+    ///     before their parents.
+    enum class layout
+    {
+        /// Depth-first post-order, so that a node
+        ///     follows the subgraphs beneath it.
+        DEPTH_FIRST,
+
+        /// Deepest level first, and within a level
+        ///     in order of first discovery.
+        LEVEL,
+    };
+
+    struct dag;
+
+    /// Thrown from within dag::emplace when the
+    ///     bound dag's budget would be exceeded,
+    ///     aborting the operation in progress.
+    ///     Every node emplaced before the abort
+    ///     remains valid, and those which are no
+    ///     longer needed can be reclaimed with
+    ///     dag::collect.
+    struct budget_exceeded : public std::runtime_error
+    {
+        enum class reason
+        {
+            NODES,
+            BYTES,
+            DEADLINE,
+        };
+
+        budget_exceeded(
+            reason a_reason
+        ) :
+            std::runtime_error(
+                a_reason == reason::NODES ? "node limit exceeded" :
+                a_reason == reason::BYTES ? "byte limit exceeded" :
+                                            "deadline exceeded"
+            ),
+            m_reason(a_reason)
+        {
+
+        }
+
+        reason m_reason;
+
+    };
+
+    /// Defines the limits of a dag. By default,
+    ///     nothing is limited.
+    struct budget
+    {
+        size_t m_node_limit = SIZE_MAX;
+        size_t m_byte_limit = SIZE_MAX;
+        std::chrono::steady_clock::time_point m_deadline =
+            std::chrono::steady_clock::time_point::max();
+
+        /// The pressure callback is invoked once
+        ///     when the node count reaches this
+        ///     threshold. It runs from within emplace,
+        ///     while the operation in progress holds
+        ///     unrooted intermediate nodes, so it must
+        ///     not collect. It may raise the limits,
+        ///     or throw to abort the operation, so
+        ///     that the caller may collect or reorder
+        ///     before retrying.
+        size_t m_pressure_node_count = SIZE_MAX;
+        std::function<void(dag&)> m_pressure;
+
+    };
+
+    /// The bits of a table of the argued width.
+    inline constexpr uint64_t leaf_mask(
+        uint32_t a_width
+    )
+    {
+        return a_width >= 6 ? UINT64_MAX : (uint64_t(1) << (1 << a_width)) - 1;
+    }
+
+    /// The bits of a table at which the argued
+    ///     variable of the leaf region is set.
+    inline constexpr uint64_t leaf_variable_mask(
+        uint32_t a_index
+    )
+    {
+        constexpr uint64_t l_masks[6] =
+        {
+            0xAAAAAAAAAAAAAAAA,
+            0xCCCCCCCCCCCCCCCC,
+            0xF0F0F0F0F0F0F0F0,
+            0xFF00FF00FF00FF00,
+            0xFFFF0000FFFF0000,
+            0xFFFFFFFF00000000,
+        };
+
+        return l_masks[a_index];
+
+    }
+
     struct dag
     {
         dag(
@@ -114,6 +366,19 @@ namespace factor
 
         }
 
+        /// Allocates the nodes from the argued memory
+        ///     resource, such as a huge_page_arena or
+        ///     a std::pmr::monotonic_buffer_resource
+        ///     discarded at the end of a job. The
+        ///     resource must outlive the dag.
+        dag(
+            std::pmr::memory_resource* a_resource
+        ) :
+            m_nodes(a_resource)
+        {
+
+        }
+
         /// We disallow shallow copying the object,
         ///     as this would cause the copied
         ///     graph's pointers to dangle.
@@ -134,6 +399,196 @@ namespace factor
             return m_nodes.size();
         }
 
+        /// Identifies the nodes held, up to emplacement:
+        ///     unique to each dag, and renewed by every
+        ///     collection which erases a node, after
+        ///     which an address may be reused.
+        uint64_t generation(
+
+        ) const
+        {
+            return m_generation;
+        }
+
+        /// The estimated memory held by the nodes,
+        ///     including the overhead of the set.
+        size_t bytes(
+
+        ) const
+        {
+            return m_nodes.size() * NODE_BYTES;
+        }
+
+        /// Replaces the limits. Unless told not to
+        ///     rearm, the pressure callback may then
+        ///     fire again, even if it already has.
+        void limit(
+            const budget& a_budget,
+            bool a_rearm = true
+        )
+        {
+            m_budget = a_budget;
+
+            if (a_rearm)
+                m_pressured = false;
+
+        }
+
+        const budget& limits(
+
+        ) const
+        {
+            return m_budget;
+        }
+
+        std::pmr::memory_resource* resource(
+
+        ) const
+        {
+            return m_nodes.get_allocator().resource();
+        }
+
+        /// Opts into truth-table leaves, so that every
+        ///     function of the argued region of at most
+        ///     six depths, which must be the deepest in
+        ///     use, is stored as a single leaf. Must be
+        ///     called before any node is emplaced. Only
+        ///     join, apply, invert, evaluate, fraction,
+        ///     node_count, collect and operator<< support
+        ///     leaves. A width of zero opts out.
+        void leaves(
+            uint32_t a_first_depth,
+            uint32_t a_width
+        )
+        {
+            if (a_width > 6)
+                throw std::runtime_error("leaf region wider than six depths");
+
+            if (!m_nodes.empty())
+                throw std::runtime_error("leaf region configured after emplacing");
+
+            m_leaf_depth = a_first_depth;
+            m_leaf_width = a_width;
+
+        }
+
+        uint32_t leaf_depth(
+
+        ) const
+        {
+            return m_leaf_depth;
+        }
+
+        uint32_t leaf_width(
+
+        ) const
+        {
+            return m_leaf_width;
+        }
+
+        /// Opts into chain nodes, which reduce each run
+        ///     of consecutive depths sharing one terminal
+        ///     child, such as the literals of a cube, to a
+        ///     single node. Must be called before any node
+        ///     is emplaced. Only join, apply, invert,
+        ///     evaluate, fraction, node_count, collect and
+        ///     operator<< support chain nodes.
+        void chains(
+            bool a_enabled
+        )
+        {
+            if (!m_nodes.empty())
+                throw std::runtime_error("chains configured after emplacing");
+
+            m_chained = a_enabled;
+
+        }
+
+        bool chained(
+
+        ) const
+        {
+            return m_chained;
+        }
+
+        /// The negative cofactor of the node on its
+        ///     first variable, emplacing the continuation
+        ///     of a chain node when it leads there.
+        const node* negative(
+            const node* a_node
+        )
+        {
+            if (a_node->chain_length() == 0)
+                return a_node->negative();
+
+            return (a_node->chain_mask() & 0x1) != 0 ? a_node->chain_terminal() : continuation(a_node);
+
+        }
+
+        const node* positive(
+            const node* a_node
+        )
+        {
+            if (a_node->chain_length() == 0)
+                return a_node->positive();
+
+            return (a_node->chain_mask() & 0x1) != 0 ? continuation(a_node) : a_node->chain_terminal();
+
+        }
+
+        /// Erases every node not reachable from the
+        ///     argued roots, returning the number of
+        ///     nodes erased. Pointers to erased nodes,
+        ///     including any held in function caches,
+        ///     are left dangling.
+        size_t collect(
+            const std::vector<const node*>& a_roots
+        )
+        {
+            std::set<const node*> l_reachable;
+            std::stack<const node*> l_stack;
+
+            for (const node* l_root : a_roots)
+                l_stack.push(l_root);
+
+            while (!l_stack.empty())
+            {
+                const node* l_node = l_stack.top();
+                l_stack.pop();
+
+                if (l_node == ZERO || l_node == ONE || !l_reachable.insert(l_node).second || l_node->is_leaf())
+                    continue;
+
+                l_stack.push(l_node->negative());
+                l_stack.push(l_node->positive());
+
+            }
+
+            size_t l_erased = 0;
+
+            for (auto l_it = m_nodes.begin(); l_it != m_nodes.end();)
+            {
+                if (l_reachable.contains(&*l_it))
+                {
+                    l_it++;
+                    continue;
+                }
+
+                l_it = m_nodes.erase(l_it);
+                l_erased++;
+
+            }
+
+            if (l_erased > 0)
+                m_generation = ++s_generations;
+
+            /// Re-arm the pressure callback.
+            m_pressured = m_nodes.size() >= m_budget.m_pressure_node_count;
+
+            return l_erased;
+
+        }
+
         const node* emplace(
             uint32_t a_depth,
             const node* a_negative_child,
@@ -146,16 +601,236 @@ namespace factor
                 ///     avoid emplacing anything.
                 return a_negative_child;
 
-            return &*m_nodes.emplace(
+            /// Within the leaf region, the children are
+            ///     tables over the deeper variables, which
+            ///     the variable selects between.
+            if (a_depth - m_leaf_depth < m_leaf_width)
+            {
+                uint64_t l_mask = leaf_variable_mask(a_depth - m_leaf_depth);
+
+                return emplace_leaf(
+                    (table(a_negative_child) & ~l_mask) | (table(a_positive_child) & l_mask)
+                );
+
+            }
+
+            /// Prepend the node to a chain, or start one,
+            ///     when one child is a terminal and the
+            ///     other continues at the next depth.
+            if (m_chained)
+            {
+                bool l_negative_terminal = a_negative_child == ZERO || a_negative_child == ONE;
+                bool l_positive_terminal = a_positive_child == ZERO || a_positive_child == ONE;
+
+                const node* l_next =
+                    l_negative_terminal && !l_positive_terminal ? a_positive_child :
+                    l_positive_terminal && !l_negative_terminal ? a_negative_child :
+                                                                  nullptr;
+                const node* l_terminal = l_next == a_positive_child ? a_negative_child : a_positive_child;
+
+                if (l_next != nullptr &&
+                    l_next->depth() == a_depth + 1 &&
+                    l_next->chain_length() < node::MAX_CHAIN_LENGTH &&
+                    (l_next->chain_length() == 0 || l_next->chain_terminal() == l_terminal))
+                    return insert(
+                        a_depth,
+                        l_next->negative(),
+                        l_next->positive(),
+                        node::chain(
+                            l_next->chain_length() + 1,
+                            (l_next->chain_mask() << 1) | (l_next == a_positive_child),
+                            l_terminal == ONE
+                        )
+                    );
+
+            }
+
+            return insert(
+                a_depth,
+                a_negative_child,
+                a_positive_child
+            );
+            
+        }
+
+        /// Emplaces the run of the argued chain node
+        ///     over a new terminal and new split children,
+        ///     such as those of its inversion, one depth at
+        ///     a time from the split upwards.
+        const node* emplace_chain(
+            const node* a_chain,
+            const node* a_terminal,
+            const node* a_negative_child,
+            const node* a_positive_child
+        )
+        {
+            const node* l_result = emplace(
+                a_chain->depth() + a_chain->chain_length(),
+                a_negative_child,
+                a_positive_child
+            );
+
+            for (uint32_t i = a_chain->chain_length(); i-- > 0;)
+            {
+                bool l_positive = ((a_chain->chain_mask() >> i) & 0x1) != 0;
+
+                l_result = emplace(
+                    a_chain->depth() + i,
+                    l_positive ? a_terminal : l_result,
+                    l_positive ? l_result : a_terminal
+                );
+
+            }
+
+            return l_result;
+
+        }
+
+        /// Emplaces a leaf of the leaf region, or the
+        ///     terminal, for a constant table.
+        const node* emplace_leaf(
+            uint64_t a_table
+        )
+        {
+            uint64_t l_mask = leaf_mask(m_leaf_width);
+
+            a_table &= l_mask;
+
+            if (a_table == 0)
+                return ZERO;
+            if (a_table == l_mask)
+                return ONE;
+
+            return insert(
+                node::LEAF_FLAG | m_leaf_depth,
+                reinterpret_cast<const node*>(a_table),
+                reinterpret_cast<const node*>(uintptr_t(m_leaf_width))
+            );
+
+        }
+
+        /// The table of a terminal or a leaf of the
+        ///     leaf region.
+        uint64_t table(
+            const node* a_node
+        ) const
+        {
+            if (a_node == ZERO)
+                return 0;
+            if (a_node == ONE)
+                return leaf_mask(m_leaf_width);
+            if (!a_node->is_leaf())
+                throw std::runtime_error("node beneath the leaf region");
+
+            return a_node->table();
+
+        }
+
+        /// Emplaces a node of a zero-suppressed DAG.
+        ///     These share the node store with the
+        ///     ordinary DAGs, but a node is dropped
+        ///     when its positive child is ZERO, rather
+        ///     than when its children are identical.
+        const node* emplace_zero_suppressed(
+            uint32_t a_depth,
+            const node* a_negative_child,
+            const node* a_positive_child
+        )
+        {
+            if (a_positive_child == ZERO)
+                /// The variable is never present in
+                ///     any set of the family, so the
+                ///     node is suppressed.
+                return a_negative_child;
+
+            return insert(
                 a_depth,
                 a_negative_child,
                 a_positive_child
-            ).first;
+            );
             
         }
         
     private:
-        std::set<node> m_nodes;
+        /// The estimated size of a node in the set,
+        ///     being the node plus the color and three
+        ///     links of the red-black tree.
+        static constexpr size_t NODE_BYTES = sizeof(node) + 4 * sizeof(void*);
+
+        /// The deadline is only polled once per
+        ///     this many emplacements.
+        static constexpr size_t DEADLINE_INTERVAL = 256;
+
+        /// The chain node one depth on, which is
+        ///     canonical, being the node the chain was
+        ///     extended from.
+        const node* continuation(
+            const node* a_node
+        )
+        {
+            return insert(
+                a_node->depth() + 1,
+                a_node->negative(),
+                a_node->positive(),
+                a_node->chain_tail()
+            );
+        }
+
+        const node* insert(
+            uint32_t a_depth,
+            const node* a_negative_child,
+            const node* a_positive_child,
+            uint32_t a_chain = 0
+        )
+        {
+            if (++m_emplacements % DEADLINE_INTERVAL == 0 &&
+                std::chrono::steady_clock::now() > m_budget.m_deadline)
+                throw budget_exceeded(budget_exceeded::reason::DEADLINE);
+
+            if (m_nodes.size() >= m_budget.m_pressure_node_count && !m_pressured)
+            {
+                m_pressured = true;
+
+                /// The callback may replace the budget,
+                ///     and with it the callback itself,
+                ///     so it is invoked from a copy.
+                std::function<void(dag&)> l_pressure = m_budget.m_pressure;
+
+                if (l_pressure)
+                    l_pressure(*this);
+
+            }
+
+            node l_node(a_depth, a_negative_child, a_positive_child, a_chain);
+
+            /// Only nodes which would grow the set
+            ///     are subject to the limits.
+            if ((m_nodes.size() >= m_budget.m_node_limit ||
+                 bytes() + NODE_BYTES > m_budget.m_byte_limit) &&
+                !m_nodes.contains(l_node))
+                throw budget_exceeded(
+                    m_nodes.size() >= m_budget.m_node_limit ?
+                        budget_exceeded::reason::NODES :
+                        budget_exceeded::reason::BYTES
+                );
+
+            return &*m_nodes.insert(l_node).first;
+
+        }
+
+        std::pmr::set<node> m_nodes;
+
+        budget m_budget;
+        bool m_pressured = false;
+        size_t m_emplacements = 0;
+
+        uint32_t m_leaf_depth = 0;
+        uint32_t m_leaf_width = 0;
+
+        bool m_chained = false;
+
+        static inline uint64_t s_generations = 0;
+        uint64_t m_generation = ++s_generations;
 
     };
 
@@ -187,14 +862,63 @@ namespace factor
         
     };
 
-    #pragma endregion
+    class global_join_engine
+    {
+        static join_engine s_engine;
 
-    ////////////////////////////////////////////
-    //////////////// ALGORITHMS ////////////////
-    ////////////////////////////////////////////
-    #pragma region ALGORITHMS
+    public:
+        static void bind(
+            join_engine a_engine
+        )
+        {
+            s_engine = a_engine;
+        }
 
-    inline const node* literal(
+        static join_engine bound(
+
+        )
+        {
+            return s_engine;
+        }
+
+    };
+
+    #pragma endregion
+
+    ////////////////////////////////////////////
+    //////////////// ALGORITHMS ////////////////
+    ////////////////////////////////////////////
+    #pragma region ALGORITHMS
+
+    /// Throws from the operations which read the
+    ///     stored children of each node, and so would
+    ///     misread the chain nodes of the bound dag.
+    inline void forbid_chains(
+        const char* a_operation
+    )
+    {
+        const dag* l_dag = global_node_sink::bound();
+
+        if (l_dag != nullptr && l_dag->chained())
+            throw std::logic_error(std::string(a_operation) + " does not support chain nodes");
+
+    }
+
+    /// Throws from the operations which would read
+    ///     the table of a truth-table leaf as a child,
+    ///     once the bound dag has a leaf region.
+    inline void forbid_leaves(
+        const char* a_operation
+    )
+    {
+        const dag* l_dag = global_node_sink::bound();
+
+        if (l_dag != nullptr && l_dag->leaf_width() != 0)
+            throw std::logic_error(std::string(a_operation) + " does not support truth-table leaves");
+
+    }
+
+    inline const node* literal(
         uint32_t a_variable_index,
         bool a_sign
     )
@@ -227,40 +951,292 @@ namespace factor
         if (a_x == a_antident || a_y == a_antident)
             return a_antident;
 
-        /// We need to make variable the
-        ///     nodes that we will recur on,
-        ///     due to the potential for
-        ///     differing node depths.
-        const node* l_x_left = a_x->negative();
-        const node* l_y_left = a_y->negative();
-        const node* l_x_right = a_x->positive();
-        const node* l_y_right = a_y->positive();
+        /// Leaves join in a single word operation.
+        if (a_x->is_leaf() && a_y->is_leaf())
+            return global_node_sink::bound()->emplace_leaf(
+                a_ident == ONE ? a_x->table() & a_y->table() : a_x->table() | a_y->table()
+            );
 
-        /// If the depths differ, we mustn't
-        ///     traverse to the children of
-        ///     the higher-depth node.
-        if (a_x->depth() > a_y->depth())
-        {
-            l_x_left = a_x;
-            l_x_right = a_x;
-        }
-        else if (a_y->depth() > a_x->depth())
-        {
-            l_y_left = a_y;
-            l_y_right = a_y;
-        }
+        dag* l_dag = global_node_sink::bound();
 
         /// Construct the cache key, which
         ///     should be the sorted pair:
         std::set<const node*> l_key = { a_x, a_y };
 
+        uint32_t l_depth = std::min(a_x->depth(), a_y->depth());
+
+        /// If the depths differ, we mustn't
+        ///     traverse to the children of
+        ///     the higher-depth node, nor take
+        ///     its cofactors, which would emplace
+        ///     the continuations of its chain.
+        bool l_x_split = a_x->depth() == l_depth;
+        bool l_y_split = a_y->depth() == l_depth;
+
         return CACHE(
             a_cache,
             l_key,
-            global_node_sink::bound()->emplace(
-                std::min(a_x->depth(), a_y->depth()),
-                join(a_cache, a_ident, a_antident, l_x_left, l_y_left),
-                join(a_cache, a_ident, a_antident, l_x_right, l_y_right)
+            l_dag->emplace(
+                l_depth,
+                join(
+                    a_cache,
+                    a_ident,
+                    a_antident,
+                    l_x_split ? l_dag->negative(a_x) : a_x,
+                    l_y_split ? l_dag->negative(a_y) : a_y
+                ),
+                join(
+                    a_cache,
+                    a_ident,
+                    a_antident,
+                    l_x_split ? l_dag->positive(a_x) : a_x,
+                    l_y_split ? l_dag->positive(a_y) : a_y
+                )
+            )
+        );
+
+    }
+
+    /// The breadth-first counterpart of join, in the
+    ///     style of CAL and Adiar. A top-down sweep
+    ///     gathers the requests of each depth into a
+    ///     sorted, deduplicated queue, and a bottom-up
+    ///     sweep then emplaces each depth's results in
+    ///     one sorted batch, looking up the children
+    ///     among the results of the deeper queues.
+    inline const node* join_breadth_first(
+        const node* a_ident,
+        const node* a_antident,
+        const node* a_x,
+        const node* a_y
+    )
+    {
+        forbid_leaves("join_breadth_first");
+
+        using request = std::pair<const node*, const node*>;
+
+        /// Resolves the requests which need no node,
+        ///     just as the base cases of join do.
+        const auto l_terminal = [a_ident, a_antident](
+            const node* a_x,
+            const node* a_y
+        ) -> std::optional<const node*>
+        {
+            if (a_x == a_ident)
+                return a_y;
+            if (a_y == a_ident)
+                return a_x;
+            if (a_x == a_antident || a_y == a_antident)
+                return a_antident;
+            if (a_x == a_y)
+                return a_x;
+
+            return std::nullopt;
+
+        };
+
+        dag* l_dag = global_node_sink::bound();
+
+        const auto l_cofactors = [l_dag](
+            const request& a_request,
+            bool a_positive
+        )
+        {
+            auto [l_x, l_y] = a_request;
+
+            uint32_t l_depth = std::min(l_x->depth(), l_y->depth());
+
+            if (l_x->depth() == l_depth)
+                l_x = a_positive ? l_dag->positive(l_x) : l_dag->negative(l_x);
+            if (l_y->depth() == l_depth)
+                l_y = a_positive ? l_dag->positive(l_y) : l_dag->negative(l_y);
+
+            return l_x < l_y ? request(l_x, l_y) : request(l_y, l_x);
+
+        };
+
+        if (std::optional<const node*> l_result = l_terminal(a_x, a_y))
+            return l_result.value();
+
+        /// The queue of requests at each depth. Children
+        ///     always lie deeper, so queues are only
+        ///     ever appended to ahead of the sweep.
+        std::map<uint32_t, std::vector<request>> l_levels;
+
+        l_levels[std::min(a_x->depth(), a_y->depth())].push_back(std::minmax(a_x, a_y));
+
+        for (auto& [l_depth, l_requests] : l_levels)
+        {
+            std::sort(l_requests.begin(), l_requests.end());
+            l_requests.erase(std::unique(l_requests.begin(), l_requests.end()), l_requests.end());
+
+            for (const request& l_request : l_requests)
+                for (bool l_positive : { false, true })
+                {
+                    request l_child = l_cofactors(l_request, l_positive);
+
+                    if (!l_terminal(l_child.first, l_child.second).has_value())
+                        l_levels[std::min(l_child.first->depth(), l_child.second->depth())].push_back(l_child);
+
+                }
+
+        }
+
+        /// The results of each depth, parallel to
+        ///     its sorted queue of requests.
+        std::map<uint32_t, std::vector<const node*>> l_results;
+
+        const auto l_resolve = [&](
+            const request& a_request
+        )
+        {
+            if (std::optional<const node*> l_result = l_terminal(a_request.first, a_request.second))
+                return l_result.value();
+
+            uint32_t l_depth = std::min(a_request.first->depth(), a_request.second->depth());
+
+            const std::vector<request>& l_requests = l_levels[l_depth];
+
+            return l_results[l_depth][
+                std::lower_bound(l_requests.begin(), l_requests.end(), a_request) - l_requests.begin()
+            ];
+
+        };
+
+        for (auto l_it = l_levels.rbegin(); l_it != l_levels.rend(); l_it++)
+        {
+            const auto& [l_depth, l_requests] = *l_it;
+
+            /// Each batch entry is a pair of children
+            ///     and the index of its request.
+            std::vector<std::tuple<const node*, const node*, size_t>> l_batch;
+
+            for (size_t i = 0; i < l_requests.size(); i++)
+                l_batch.emplace_back(
+                    l_resolve(l_cofactors(l_requests[i], false)),
+                    l_resolve(l_cofactors(l_requests[i], true)),
+                    i
+                );
+
+            /// Emplace in the order of the unique table.
+            std::sort(l_batch.begin(), l_batch.end());
+
+            std::vector<const node*>& l_level_results = l_results[l_depth];
+
+            l_level_results.resize(l_requests.size());
+
+            for (const auto& [l_negative, l_positive, l_index] : l_batch)
+                l_level_results[l_index] = global_node_sink::bound()->emplace(l_depth, l_negative, l_positive);
+
+        }
+
+        return l_resolve(std::minmax(a_x, a_y));
+
+    }
+
+    /// Applies any of the sixteen binary operations
+    ///     in a single traversal of both operands.
+    ///     The cache may be shared between calls
+    ///     applying different operations, and may be
+    ///     any map keyed by the operation and operands,
+    ///     such as a std::pmr::map allocating from the
+    ///     same memory resource as the dag.
+    template<typename MAP>
+    inline const node* apply(
+        MAP& a_cache,
+        operation a_operation,
+        const node* a_x,
+        const node* a_y
+    )
+    {
+        const auto l_result = [a_operation](bool a_x_value, bool a_y_value)
+        {
+            return ((uint8_t)a_operation >> (2 * a_x_value + a_y_value) & 0x1) != 0;
+        };
+
+        bool l_x_terminal = a_x == ZERO || a_x == ONE;
+        bool l_y_terminal = a_y == ZERO || a_y == ONE;
+
+        if (l_x_terminal && l_y_terminal)
+            return l_result(a_x == ONE, a_y == ONE) ? ONE : ZERO;
+
+        /// With one terminal operand, the result is
+        ///     either constant, the other operand, or
+        ///     its inversion, which is left to recursion.
+        if (l_x_terminal || l_y_terminal || a_x == a_y)
+        {
+            const node* l_other = l_x_terminal ? a_y : a_x;
+
+            bool l_negative_result =
+                l_x_terminal ? l_result(a_x == ONE, false) :
+                l_y_terminal ? l_result(false, a_y == ONE) :
+                               l_result(false, false);
+            bool l_positive_result =
+                l_x_terminal ? l_result(a_x == ONE, true) :
+                l_y_terminal ? l_result(true, a_y == ONE) :
+                               l_result(true, true);
+
+            if (l_negative_result == l_positive_result)
+                return l_negative_result ? ONE : ZERO;
+
+            if (l_positive_result)
+                return l_other;
+
+        }
+
+        /// Within the leaf region, the operation
+        ///     applies to the tables bitwise.
+        if ((l_x_terminal || a_x->is_leaf()) && (l_y_terminal || a_y->is_leaf()))
+        {
+            dag* l_dag = global_node_sink::bound();
+
+            uint64_t l_x = l_dag->table(a_x);
+            uint64_t l_y = l_dag->table(a_y);
+
+            return l_dag->emplace_leaf(
+                (l_result(false, false) ? ~l_x & ~l_y : 0) |
+                (l_result(false, true) ? ~l_x & l_y : 0) |
+                (l_result(true, false) ? l_x & ~l_y : 0) |
+                (l_result(true, true) ? l_x & l_y : 0)
+            );
+
+        }
+
+        /// Commutative operations are keyed by
+        ///     the sorted pair of operands.
+        std::tuple<operation, const node*, const node*> l_key = { a_operation, a_x, a_y };
+
+        if (l_result(false, true) == l_result(true, false) && a_y < a_x)
+            l_key = { a_operation, a_y, a_x };
+
+        if (a_cache.contains(l_key))
+            return a_cache[l_key];
+
+        uint32_t l_depth =
+            l_x_terminal ? a_y->depth() :
+            l_y_terminal ? a_x->depth() :
+                           std::min(a_x->depth(), a_y->depth());
+
+        /// As in factor::join, we mustn't traverse to
+        ///     the children of the deeper operand.
+        bool l_x_split = !l_x_terminal && a_x->depth() == l_depth;
+        bool l_y_split = !l_y_terminal && a_y->depth() == l_depth;
+
+        dag* l_dag = global_node_sink::bound();
+
+        return a_cache[l_key] = l_dag->emplace(
+            l_depth,
+            apply(
+                a_cache,
+                a_operation,
+                l_x_split ? l_dag->negative(a_x) : a_x,
+                l_y_split ? l_dag->negative(a_y) : a_y
+            ),
+            apply(
+                a_cache,
+                a_operation,
+                l_x_split ? l_dag->positive(a_x) : a_x,
+                l_y_split ? l_dag->positive(a_y) : a_y
             )
         );
 
@@ -276,8 +1252,25 @@ namespace factor
         if (a_node == ONE)
             return ZERO;
 
+        if (a_node->is_leaf())
+            return global_node_sink::bound()->emplace_leaf(~a_node->table());
+
         /// Query the cache and if it is not
         ///     found, store the computed result.
+        /// A chain inverts as a whole, by inverting
+        ///     its terminal and its split.
+        if (a_node->chain_length() != 0)
+            return CACHE(
+                a_cache,
+                a_node,
+                global_node_sink::bound()->emplace_chain(
+                    a_node,
+                    a_node->chain_terminal() == ONE ? ZERO : ONE,
+                    invert(a_cache, a_node->negative()),
+                    invert(a_cache, a_node->positive())
+                )
+            );
+
         return CACHE(
             a_cache,
             a_node,
@@ -290,6 +1283,118 @@ namespace factor
 
     }
 
+    /// The Coudert-Madre generalized cofactor. Agrees
+    ///     with the function wherever the care function
+    ///     holds, mapping every other assignment to the
+    ///     nearest one where it holds. The result is
+    ///     usually far smaller than the function.
+    inline const node* constrain(
+        std::map<std::pair<const node*, const node*>, const node*>& a_cache,
+        const node* a_node,
+        const node* a_care
+    )
+    {
+        /// With no care assignments, any result agrees.
+        if (a_care == ZERO)
+            return ZERO;
+        if (a_care == ONE || a_node == ZERO || a_node == ONE)
+            return a_node;
+        if (a_node == a_care)
+            return ONE;
+
+        forbid_leaves("constrain");
+
+        std::pair<const node*, const node*> l_key = { a_node, a_care };
+
+        if (a_cache.contains(l_key))
+            return a_cache[l_key];
+
+        uint32_t l_depth = std::min(a_node->depth(), a_care->depth());
+
+        bool l_node_split = a_node->depth() == l_depth;
+        bool l_care_split = a_care->depth() == l_depth;
+
+        dag* l_dag = global_node_sink::bound();
+
+        const node* l_node_negative = l_node_split ? l_dag->negative(a_node) : a_node;
+        const node* l_node_positive = l_node_split ? l_dag->positive(a_node) : a_node;
+        const node* l_care_negative = l_care_split ? l_dag->negative(a_care) : a_care;
+        const node* l_care_positive = l_care_split ? l_dag->positive(a_care) : a_care;
+
+        /// If only one side is cared for, the variable
+        ///     is dropped and that side is taken.
+        if (l_care_negative == ZERO)
+            return a_cache[l_key] = constrain(a_cache, l_node_positive, l_care_positive);
+        if (l_care_positive == ZERO)
+            return a_cache[l_key] = constrain(a_cache, l_node_negative, l_care_negative);
+
+        return a_cache[l_key] = l_dag->emplace(
+            l_depth,
+            constrain(a_cache, l_node_negative, l_care_negative),
+            constrain(a_cache, l_node_positive, l_care_positive)
+        );
+
+    }
+
+    /// Like constrain, but the care function is first
+    ///     quantified over the variables the function
+    ///     does not depend on, so that the result never
+    ///     gains a variable absent from the function.
+    ///     The disjunctions this needs are applied
+    ///     through the second cache.
+    inline const node* restrict(
+        std::map<std::pair<const node*, const node*>, const node*>& a_cache,
+        std::map<std::tuple<operation, const node*, const node*>, const node*>& a_applications,
+        const node* a_node,
+        const node* a_care
+    )
+    {
+        if (a_care == ZERO)
+            return ZERO;
+        if (a_care == ONE || a_node == ZERO || a_node == ONE)
+            return a_node;
+        if (a_node == a_care)
+            return ONE;
+
+        forbid_leaves("restrict");
+
+        std::pair<const node*, const node*> l_key = { a_node, a_care };
+
+        if (a_cache.contains(l_key))
+            return a_cache[l_key];
+
+        dag* l_dag = global_node_sink::bound();
+
+        /// The care function branches on a variable
+        ///     the function does not, so it is dropped.
+        if (a_care->depth() < a_node->depth())
+            return a_cache[l_key] = restrict(
+                a_cache,
+                a_applications,
+                a_node,
+                apply(a_applications, operation::OR, l_dag->negative(a_care), l_dag->positive(a_care))
+            );
+
+        bool l_care_split = a_care->depth() == a_node->depth();
+
+        const node* l_node_negative = l_dag->negative(a_node);
+        const node* l_node_positive = l_dag->positive(a_node);
+        const node* l_care_negative = l_care_split ? l_dag->negative(a_care) : a_care;
+        const node* l_care_positive = l_care_split ? l_dag->positive(a_care) : a_care;
+
+        if (l_care_negative == ZERO)
+            return a_cache[l_key] = restrict(a_cache, a_applications, l_node_positive, l_care_positive);
+        if (l_care_positive == ZERO)
+            return a_cache[l_key] = restrict(a_cache, a_applications, l_node_negative, l_care_negative);
+
+        return a_cache[l_key] = l_dag->emplace(
+            a_node->depth(),
+            restrict(a_cache, a_applications, l_node_negative, l_care_negative),
+            restrict(a_cache, a_applications, l_node_positive, l_care_positive)
+        );
+
+    }
+
     /// Evaluates the function represented by the
     ///     factor DAG on the argued input.
     inline bool evaluate(
@@ -303,13 +1408,564 @@ namespace factor
         if (a_node == ONE)
             return true;
 
-        if (a_input[a_node->depth()])
+        if (a_node->is_leaf())
+        {
+            uint32_t l_bit = 0;
+
+            for (uint32_t i = 0; i < a_node->leaf_width(); i++)
+                l_bit |= uint32_t(a_input[a_node->leaf_depth() + i]) << i;
+
+            return (a_node->table() >> l_bit) & 0x1;
+
+        }
+
+        /// Leaving a chain reaches its terminal.
+        for (uint32_t i = 0; i < a_node->chain_length(); i++)
+            if (a_input[a_node->depth() + i] != (((a_node->chain_mask() >> i) & 0x1) != 0))
+                return a_node->chain_terminal() == ONE;
+
+        if (a_input[a_node->depth() + a_node->chain_length()])
             return evaluate(a_node->positive(), a_input);
         else
             return evaluate(a_node->negative(), a_input);
             
     }
 
+    /// Decides whether the conjunction of the two
+    ///     functions is ZERO, without emplacing any
+    ///     node but the continuations of chain nodes,
+    ///     and returning on the first witness. The
+    ///     cache holds the pairs proven disjoint.
+    inline bool is_disjoint(
+        std::set<std::pair<const node*, const node*>>& a_cache,
+        const node* a_x,
+        const node* a_y
+    )
+    {
+        if (a_x == ZERO || a_y == ZERO)
+            return true;
+
+        /// Both operands are non-zero, so any
+        ///     of these have a common assignment.
+        if (a_x == ONE || a_y == ONE || a_x == a_y)
+            return false;
+
+        std::pair<const node*, const node*> l_key = std::minmax(a_x, a_y);
+
+        if (a_cache.contains(l_key))
+            return true;
+
+        /// Leaves are disjoint when their tables are.
+        if (a_x->is_leaf() && a_y->is_leaf())
+            return (a_x->table() & a_y->table()) == 0;
+
+        uint32_t l_depth = std::min(a_x->depth(), a_y->depth());
+
+        bool l_x_split = a_x->depth() == l_depth;
+        bool l_y_split = a_y->depth() == l_depth;
+
+        dag* l_dag = global_node_sink::bound();
+
+        bool l_result =
+            is_disjoint(
+                a_cache,
+                l_x_split ? l_dag->negative(a_x) : a_x,
+                l_y_split ? l_dag->negative(a_y) : a_y
+            ) &&
+            is_disjoint(
+                a_cache,
+                l_x_split ? l_dag->positive(a_x) : a_x,
+                l_y_split ? l_dag->positive(a_y) : a_y
+            );
+
+        if (l_result)
+            a_cache.insert(l_key);
+
+        return l_result;
+
+    }
+
+    /// Decides whether the first function implies
+    ///     the second, without emplacing any node but
+    ///     the continuations of chain nodes. The
+    ///     cache holds the pairs proven to imply.
+    inline bool implies(
+        std::set<std::pair<const node*, const node*>>& a_cache,
+        const node* a_x,
+        const node* a_y
+    )
+    {
+        if (a_x == ZERO || a_y == ONE || a_x == a_y)
+            return true;
+        if (a_x == ONE || a_y == ZERO)
+            return false;
+
+        std::pair<const node*, const node*> l_key = { a_x, a_y };
+
+        if (a_cache.contains(l_key))
+            return true;
+
+        /// One leaf implies another when its table
+        ///     sets no bit the other leaves clear.
+        if (a_x->is_leaf() && a_y->is_leaf())
+            return (a_x->table() & ~a_y->table()) == 0;
+
+        uint32_t l_depth = std::min(a_x->depth(), a_y->depth());
+
+        bool l_x_split = a_x->depth() == l_depth;
+        bool l_y_split = a_y->depth() == l_depth;
+
+        dag* l_dag = global_node_sink::bound();
+
+        bool l_result =
+            implies(
+                a_cache,
+                l_x_split ? l_dag->negative(a_x) : a_x,
+                l_y_split ? l_dag->negative(a_y) : a_y
+            ) &&
+            implies(
+                a_cache,
+                l_x_split ? l_dag->positive(a_x) : a_x,
+                l_y_split ? l_dag->positive(a_y) : a_y
+            );
+
+        if (l_result)
+            a_cache.insert(l_key);
+
+        return l_result;
+
+    }
+
+    /// Decides whether the two functions agree on
+    ///     every assignment satisfying the constraint,
+    ///     without emplacing any node but the
+    ///     continuations of chain nodes. The cache
+    ///     holds the triples proven to agree.
+    inline bool equal_under(
+        std::set<std::tuple<const node*, const node*, const node*>>& a_cache,
+        const node* a_x,
+        const node* a_y,
+        const node* a_constraint
+    )
+    {
+        if (a_constraint == ZERO || a_x == a_y)
+            return true;
+
+        /// The functions differ somewhere, and the
+        ///     constraint is satisfied everywhere.
+        if (a_constraint == ONE)
+            return false;
+
+        /// The functions are distinct constants, and
+        ///     the constraint is satisfied somewhere.
+        if ((a_x == ZERO || a_x == ONE) && (a_y == ZERO || a_y == ONE))
+            return false;
+
+        std::tuple<const node*, const node*, const node*> l_key =
+            { std::min(a_x, a_y), std::max(a_x, a_y), a_constraint };
+
+        if (a_cache.contains(l_key))
+            return true;
+
+        uint32_t l_depth = a_constraint->depth();
+
+        for (const node* l_node : { a_x, a_y })
+            if (l_node != ZERO && l_node != ONE)
+                l_depth = std::min(l_depth, l_node->depth());
+
+        dag* l_dag = global_node_sink::bound();
+
+        /// Within the leaf region, the tables must
+        ///     agree on the rows the constraint sets.
+        if (a_constraint->is_leaf() && l_depth == a_constraint->depth())
+            return ((l_dag->table(a_x) ^ l_dag->table(a_y)) & a_constraint->table()) == 0;
+
+        const auto l_cofactor = [l_dag, l_depth](const node* a_node, bool a_positive)
+        {
+            if (a_node == ZERO || a_node == ONE || a_node->depth() != l_depth)
+                return a_node;
+
+            return a_positive ? l_dag->positive(a_node) : l_dag->negative(a_node);
+        };
+
+        bool l_result =
+            equal_under(
+                a_cache,
+                l_cofactor(a_x, false),
+                l_cofactor(a_y, false),
+                l_cofactor(a_constraint, false)
+            ) &&
+            equal_under(
+                a_cache,
+                l_cofactor(a_x, true),
+                l_cofactor(a_y, true),
+                l_cofactor(a_constraint, true)
+            );
+
+        if (l_result)
+            a_cache.insert(l_key);
+
+        return l_result;
+
+    }
+
+    /// Returns the number of nodes reachable
+    ///     from the argued node, itself included.
+    inline size_t node_count(
+        const node* a_node
+    )
+    {
+        std::set<const node*> l_visited;
+        std::stack<const node*> l_stack;
+
+        l_stack.push(a_node);
+
+        while (!l_stack.empty())
+        {
+            const node* l_node = l_stack.top();
+            l_stack.pop();
+
+            if (l_node == ZERO || l_node == ONE || !l_visited.insert(l_node).second || l_node->is_leaf())
+                continue;
+
+            l_stack.push(l_node->negative());
+            l_stack.push(l_node->positive());
+
+        }
+
+        return l_visited.size();
+
+    }
+
+    /// Returns the fraction of all assignments
+    ///     to the variables which satisfy the
+    ///     function represented by the factor DAG.
+    inline double fraction(
+        std::map<const node*, double>& a_cache,
+        const node* a_node
+    )
+    {
+        if (a_node == ZERO)
+            return 0.0;
+        if (a_node == ONE)
+            return 1.0;
+
+        if (a_node->is_leaf())
+            return std::ldexp(std::popcount(a_node->table()), -(int)a_node->leaf_width());
+
+        /// Each chained variable leaves the chain
+        ///     with probability one half.
+        double l_stay = std::ldexp(1.0, -(int)a_node->chain_length());
+        double l_leave = a_node->chain_terminal() == ONE ? 1.0 - l_stay : 0.0;
+
+        return CACHE(
+            a_cache,
+            a_node,
+            l_leave + l_stay * (fraction(a_cache, a_node->negative()) + fraction(a_cache, a_node->positive())) / 2.0
+        );
+
+    }
+
+    /// Counts the satisfying assignments to the
+    ///     first argued number of variables.
+    inline double count(
+        const node* a_node,
+        uint32_t a_variable_count
+    )
+    {
+        std::map<const node*, double> l_cache;
+
+        return std::ldexp(fraction(l_cache, a_node), a_variable_count);
+
+    }
+
+    /// Copies the nodes reachable from the roots into
+    ///     the destination dag, which should be fresh,
+    ///     emplacing them in the argued layout so that
+    ///     they are allocated close together. Returns
+    ///     the roots remapped into the destination, after
+    ///     which the source dag may be discarded.
+    inline std::vector<const node*> compact(
+        dag& a_destination,
+        const std::vector<const node*>& a_roots,
+        layout a_layout
+    )
+    {
+        forbid_leaves("compact");
+
+        std::map<const node*, const node*> l_remapped = { { ZERO, ZERO }, { ONE, ONE } };
+
+        /// The reachable nodes, children before parents.
+        std::vector<const node*> l_order;
+
+        if (a_layout == layout::DEPTH_FIRST)
+        {
+            std::set<const node*> l_visited;
+            std::stack<std::pair<const node*, bool>> l_stack;
+
+            for (auto l_it = a_roots.rbegin(); l_it != a_roots.rend(); l_it++)
+                l_stack.emplace(*l_it, false);
+
+            while (!l_stack.empty())
+            {
+                auto [l_node, l_expanded] = l_stack.top();
+                l_stack.pop();
+
+                if (l_expanded)
+                {
+                    l_order.push_back(l_node);
+                    continue;
+                }
+
+                if (l_node == ZERO || l_node == ONE || !l_visited.insert(l_node).second)
+                    continue;
+
+                l_stack.emplace(l_node, true);
+                l_stack.emplace(l_node->positive(), false);
+                l_stack.emplace(l_node->negative(), false);
+
+            }
+
+        }
+        else
+        {
+            std::map<uint32_t, std::vector<const node*>> l_levels;
+            std::set<const node*> l_visited;
+            std::vector<const node*> l_frontier(a_roots.begin(), a_roots.end());
+
+            /// Breadth-first discovery, bucketed by depth.
+            for (size_t i = 0; i < l_frontier.size(); i++)
+            {
+                const node* l_node = l_frontier[i];
+
+                if (l_node == ZERO || l_node == ONE || !l_visited.insert(l_node).second)
+                    continue;
+
+                l_levels[l_node->depth()].push_back(l_node);
+                l_frontier.push_back(l_node->negative());
+                l_frontier.push_back(l_node->positive());
+
+            }
+
+            for (auto l_it = l_levels.rbegin(); l_it != l_levels.rend(); l_it++)
+                l_order.insert(l_order.end(), l_it->second.begin(), l_it->second.end());
+
+        }
+
+        /// A chain node is copied as its run, which the
+        ///     destination chains again if it is chained.
+        for (const node* l_node : l_order)
+            l_remapped[l_node] = l_node->chain_length() != 0 ?
+                a_destination.emplace_chain(
+                    l_node,
+                    l_node->chain_terminal(),
+                    l_remapped[l_node->negative()],
+                    l_remapped[l_node->positive()]
+                ) :
+                a_destination.emplace(
+                    l_node->depth(),
+                    l_remapped[l_node->negative()],
+                    l_remapped[l_node->positive()]
+                );
+
+        std::vector<const node*> l_result;
+
+        for (const node* l_root : a_roots)
+            l_result.push_back(l_remapped[l_root]);
+
+        return l_result;
+
+    }
+
+    /// Returns the variables the function branches on.
+    inline std::set<uint32_t> support(
+        const node* a_node
+    )
+    {
+        std::set<uint32_t> l_result;
+        std::set<const node*> l_visited;
+        std::stack<const node*> l_stack;
+
+        l_stack.push(a_node);
+
+        while (!l_stack.empty())
+        {
+            const node* l_node = l_stack.top();
+            l_stack.pop();
+
+            if (l_node == ZERO || l_node == ONE || !l_visited.insert(l_node).second)
+                continue;
+
+            /// A leaf depends on each variable whose
+            ///     cofactor tables differ.
+            if (l_node->is_leaf())
+            {
+                for (uint32_t i = 0; i < l_node->leaf_width(); i++)
+                    if ((((l_node->table() >> (1 << i)) ^ l_node->table()) & ~leaf_variable_mask(i)) != 0)
+                        l_result.insert(l_node->leaf_depth() + i);
+
+                continue;
+
+            }
+
+            /// A chain node branches on each chained
+            ///     depth, and then on its split depth.
+            for (uint32_t i = 0; i <= l_node->chain_length(); i++)
+                l_result.insert(l_node->depth() + i);
+
+            l_stack.push(l_node->negative());
+            l_stack.push(l_node->positive());
+
+        }
+
+        return l_result;
+
+    }
+
+    /// Copies the structure of the DAG with each depth
+    ///     relabeled through the mapping, in one pass with
+    ///     no joins. Unmapped variables keep their index.
+    ///     The mapping must preserve the order of the
+    ///     function's variables, otherwise use permute.
+    inline const node* relabel(
+        std::map<const node*, const node*>& a_cache,
+        const std::map<uint32_t, uint32_t>& a_mapping,
+        const node* a_node
+    )
+    {
+        if (a_node == ZERO || a_node == ONE)
+            return a_node;
+
+        forbid_leaves("relabel");
+
+        auto l_target = a_mapping.find(a_node->depth());
+
+        dag* l_dag = global_node_sink::bound();
+
+        return CACHE(
+            a_cache,
+            a_node,
+            l_dag->emplace(
+                l_target == a_mapping.end() ? a_node->depth() : l_target->second,
+                relabel(a_cache, a_mapping, l_dag->negative(a_node)),
+                relabel(a_cache, a_mapping, l_dag->positive(a_node))
+            )
+        );
+
+    }
+
+    /// Shifts every variable of the function by the
+    ///     argued offset, instantiating a prebuilt
+    ///     template circuit over other variables.
+    inline const node* shift(
+        std::map<const node*, const node*>& a_cache,
+        const node* a_node,
+        int64_t a_offset
+    )
+    {
+        std::map<uint32_t, uint32_t> l_mapping;
+
+        for (uint32_t l_variable : support(a_node))
+            l_mapping[l_variable] = l_variable + a_offset;
+
+        return relabel(a_cache, l_mapping, a_node);
+
+    }
+
+    /// Renames the variables of the function through
+    ///     an arbitrary mapping. Order-preserving mappings
+    ///     take the relabel fast path, while any other
+    ///     rebuilds each node as an if-then-else over
+    ///     its renamed variable, through the apply cache.
+    ///     The first cache must only be shared between
+    ///     calls renaming through the same mapping.
+    inline const node* permute(
+        std::map<const node*, const node*>& a_cache,
+        std::map<std::tuple<operation, const node*, const node*>, const node*>& a_applications,
+        const std::map<uint32_t, uint32_t>& a_mapping,
+        const node* a_node
+    )
+    {
+        forbid_leaves("permute");
+
+        const auto l_target = [&a_mapping](uint32_t a_variable)
+        {
+            auto l_it = a_mapping.find(a_variable);
+            return l_it == a_mapping.end() ? a_variable : l_it->second;
+        };
+
+        /// Check whether the renamed support keeps its order.
+        bool l_ordered = true;
+        std::optional<uint32_t> l_previous;
+
+        for (uint32_t l_variable : support(a_node))
+        {
+            if (l_previous.has_value() && l_target(l_variable) <= l_previous.value())
+            {
+                l_ordered = false;
+                break;
+            }
+
+            l_previous = l_target(l_variable);
+
+        }
+
+        if (l_ordered)
+            return relabel(a_cache, a_mapping, a_node);
+
+        dag* l_dag = global_node_sink::bound();
+
+        /// The children are renamed first, and then
+        ///     the node is selected by its variable.
+        std::vector<const node*> l_nodes;
+        std::stack<std::pair<const node*, bool>> l_stack;
+
+        l_stack.emplace(a_node, false);
+
+        while (!l_stack.empty())
+        {
+            auto [l_node, l_expanded] = l_stack.top();
+            l_stack.pop();
+
+            if (l_node == ZERO || l_node == ONE || a_cache.contains(l_node))
+                continue;
+
+            if (l_expanded)
+            {
+                const node* l_variable = literal(l_target(l_node->depth()), true);
+
+                const node* l_negative = l_dag->negative(l_node);
+                const node* l_positive = l_dag->positive(l_node);
+
+                if (l_negative != ZERO && l_negative != ONE)
+                    l_negative = a_cache[l_negative];
+                if (l_positive != ZERO && l_positive != ONE)
+                    l_positive = a_cache[l_positive];
+
+                a_cache[l_node] = apply(
+                    a_applications,
+                    operation::OR,
+                    apply(a_applications, operation::AND, l_variable, l_positive),
+                    apply(a_applications, operation::NONIMPLICATION, l_negative, l_variable)
+                );
+
+                continue;
+
+            }
+
+            l_stack.emplace(l_node, true);
+            l_stack.emplace(l_dag->negative(l_node), false);
+            l_stack.emplace(l_dag->positive(l_node), false);
+
+        }
+
+        if (a_node == ZERO || a_node == ONE)
+            return a_node;
+
+        return a_cache[a_node];
+
+    }
+
     #pragma endregion
 
 }
@@ -337,17 +1993,47 @@ namespace logic
         const factor::node* a_y
     )
     {
-        /// Construct the function cache.
-        std::map<std::set<const factor::node*>, const factor::node*> l_cache;
-
-        return factor::join(
-            l_cache,
-            a_identity ? factor::ONE : factor::ZERO,
-            a_identity ? factor::ZERO : factor::ONE,
-            a_x,
-            a_y
+        FACTOR_TRACE_SCOPE(
+            l_scope,
+            a_identity ? "conjoin" : "disjoin",
+            factor::global_node_sink::bound()->size(),
+            FACTOR_TRACE_SIZE(factor::node_count(a_x)),
+            FACTOR_TRACE_SIZE(factor::node_count(a_y))
         );
 
+        const factor::node* l_result;
+
+        /// The breadth-first engine knows nothing
+        ///     of truth-table leaves or chain nodes.
+        if (factor::global_join_engine::bound() == factor::join_engine::BREADTH_FIRST &&
+            factor::global_node_sink::bound()->leaf_width() == 0 &&
+            !factor::global_node_sink::bound()->chained())
+        {
+            l_result = factor::join_breadth_first(
+                a_identity ? factor::ONE : factor::ZERO,
+                a_identity ? factor::ZERO : factor::ONE,
+                a_x,
+                a_y
+            );
+        }
+        else
+        {
+            /// Construct the function cache.
+            std::map<std::set<const factor::node*>, const factor::node*> l_cache;
+
+            l_result = factor::join(
+                l_cache,
+                a_identity ? factor::ONE : factor::ZERO,
+                a_identity ? factor::ZERO : factor::ONE,
+                a_x,
+                a_y
+            );
+        }
+
+        FACTOR_TRACE_FINISH(l_scope, factor::global_node_sink::bound()->size(), FACTOR_TRACE_SIZE(factor::node_count(l_result)));
+
+        return l_result;
+
     }
 
     template<>
@@ -355,14 +2041,99 @@ namespace logic
         const factor::node* a_node
     )
     {
+        FACTOR_TRACE_SCOPE(
+            l_scope,
+            "invert",
+            factor::global_node_sink::bound()->size(),
+            FACTOR_TRACE_SIZE(factor::node_count(a_node))
+        );
+
         /// Construct the function cache.
         std::map<const factor::node*, const factor::node*> l_cache;
 
         /// Call the overload, supplying the cache.
-        return factor::invert(l_cache, a_node);
+        const factor::node* l_result = factor::invert(l_cache, a_node);
+
+        FACTOR_TRACE_FINISH(l_scope, factor::global_node_sink::bound()->size(), FACTOR_TRACE_SIZE(factor::node_count(l_result)));
+
+        return l_result;
         
     }
 
+    /// The exclusive or is built by factor::apply
+    ///     in a single traversal, rather than through
+    ///     separate conjunctions and inversions. These
+    ///     are specializations, so that the generic
+    ///     adders and comparators of logic.h reach them.
+    template<>
+    inline const factor::node* exor(
+        const factor::node* a_x,
+        const factor::node* a_y
+    )
+    {
+        std::map<std::tuple<factor::operation, const factor::node*, const factor::node*>, const factor::node*> l_cache;
+
+        return factor::apply(l_cache, factor::operation::XOR, a_x, a_y);
+
+    }
+
+    /// The three-input form is the sum bit of every
+    ///     full adder, so it shares one apply cache.
+    template<>
+    inline const factor::node* exor(
+        const factor::node* a_x,
+        const factor::node* a_y,
+        const factor::node* a_z
+    )
+    {
+        std::map<std::tuple<factor::operation, const factor::node*, const factor::node*>, const factor::node*> l_cache;
+
+        return factor::apply(
+            l_cache,
+            factor::operation::XOR,
+            factor::apply(l_cache, factor::operation::XOR, a_x, a_y),
+            a_z
+        );
+
+    }
+
+    template<>
+    inline const factor::node* exnor(
+        const factor::node* a_x,
+        const factor::node* a_y
+    )
+    {
+        std::map<std::tuple<factor::operation, const factor::node*, const factor::node*>, const factor::node*> l_cache;
+
+        return factor::apply(l_cache, factor::operation::XNOR, a_x, a_y);
+
+    }
+
+    /// Simplifies the function against the care
+    ///     function, prior to further conjunctions.
+    inline const factor::node* constrain(
+        const factor::node* a_node,
+        const factor::node* a_care
+    )
+    {
+        std::map<std::pair<const factor::node*, const factor::node*>, const factor::node*> l_cache;
+
+        return factor::constrain(l_cache, a_node, a_care);
+
+    }
+
+    inline const factor::node* restrict(
+        const factor::node* a_node,
+        const factor::node* a_care
+    )
+    {
+        std::map<std::pair<const factor::node*, const factor::node*>, const factor::node*> l_cache;
+        std::map<std::tuple<factor::operation, const factor::node*, const factor::node*>, const factor::node*> l_applications;
+
+        return factor::restrict(l_cache, l_applications, a_node, a_care);
+
+    }
+
     #pragma endregion
     
 }
@@ -0,0 +1,263 @@
+#ifndef FROZEN_H
+#define FROZEN_H
+
+#include <memory>
+#include <optional>
+
+#include "factor.h"
+
+namespace factor
+{
+
+    ////////////////////////////////////////////
+    ////////////// DATA STRUCTURES /////////////
+    ////////////////////////////////////////////
+    #pragma region DATA STRUCTURES
+
+    /// An immutable snapshot of the DAGs reachable
+    ///     from a set of roots, held in one flat array
+    ///     with children before parents, and owning no
+    ///     pointers into the source dag. Every member is
+    ///     const, so any number of threads may query a
+    ///     shared snapshot without synchronization.
+    class frozen
+    {
+    public:
+
+        /// The indices of the terminals. Every
+        ///     other index refers to a node.
+        static constexpr uint32_t ZERO_INDEX = 0;
+        static constexpr uint32_t ONE_INDEX = 1;
+
+        struct entry
+        {
+            uint32_t m_depth;
+            uint32_t m_negative;
+            uint32_t m_positive;
+        };
+
+    private:
+
+        /// The nodes, with the two terminals first.
+        std::vector<entry> m_entries;
+
+        /// The fraction of all assignments satisfying
+        ///     each node, computed once at freezing.
+        std::vector<double> m_fractions;
+
+        std::vector<uint32_t> m_roots;
+
+        frozen(
+
+        )
+        {
+
+        }
+
+        friend std::shared_ptr<const frozen> freeze(
+            const std::vector<const node*>& a_roots
+        );
+
+    public:
+
+        size_t size(
+
+        ) const
+        {
+            return m_entries.size() - 2;
+        }
+
+        size_t root_count(
+
+        ) const
+        {
+            return m_roots.size();
+        }
+
+        bool evaluate(
+            size_t a_root,
+            const std::vector<bool>& a_input
+        ) const
+        {
+            uint32_t l_index = m_roots[a_root];
+
+            while (l_index > ONE_INDEX)
+            {
+                const entry& l_entry = m_entries[l_index];
+                l_index = a_input[l_entry.m_depth] ? l_entry.m_positive : l_entry.m_negative;
+            }
+
+            return l_index == ONE_INDEX;
+
+        }
+
+        /// Counts the satisfying assignments over the
+        ///     argued number of variables.
+        double sat_count(
+            size_t a_root,
+            uint32_t a_variable_count
+        ) const
+        {
+            return std::ldexp(m_fractions[m_roots[a_root]], a_variable_count);
+        }
+
+        /// Returns a satisfying assignment over the
+        ///     argued number of variables, with the
+        ///     unconstrained variables left false, or
+        ///     nullopt if the root is unsatisfiable.
+        std::optional<std::vector<bool>> any_sat(
+            size_t a_root,
+            uint32_t a_variable_count
+        ) const
+        {
+            uint32_t l_index = m_roots[a_root];
+
+            if (l_index == ZERO_INDEX)
+                return std::nullopt;
+
+            std::vector<bool> l_result(a_variable_count);
+
+            /// Every node is satisfiable, so any child
+            ///     other than ZERO leads to ONE. This is
+            ///     decided structurally, as the fractions
+            ///     underflow to zero on deep DAGs.
+            while (l_index != ONE_INDEX)
+            {
+                const entry& l_entry = m_entries[l_index];
+
+                bool l_positive = l_entry.m_negative == ZERO_INDEX;
+
+                l_result[l_entry.m_depth] = l_positive;
+                l_index = l_positive ? l_entry.m_positive : l_entry.m_negative;
+
+            }
+
+            return l_result;
+
+        }
+
+        /// Prints the root exactly as operator<<
+        ///     prints the node it was frozen from.
+        void print(
+            std::ostream& a_ostream,
+            size_t a_root
+        ) const
+        {
+            print_index(a_ostream, m_roots[a_root]);
+        }
+
+    private:
+
+        void print_index(
+            std::ostream& a_ostream,
+            uint32_t a_index
+        ) const
+        {
+            if (a_index <= ONE_INDEX)
+                return;
+
+            const entry& l_entry = m_entries[a_index];
+
+            bool l_both = l_entry.m_negative != ZERO_INDEX && l_entry.m_positive != ZERO_INDEX;
+
+            if (l_both)
+                a_ostream << "(";
+
+            if (l_entry.m_negative != ZERO_INDEX)
+            {
+                a_ostream << "[" << l_entry.m_depth << "]'";
+                print_index(a_ostream, l_entry.m_negative);
+            }
+
+            if (l_both)
+                a_ostream << "+";
+
+            if (l_entry.m_positive != ZERO_INDEX)
+            {
+                a_ostream << "[" << l_entry.m_depth << "]";
+                print_index(a_ostream, l_entry.m_positive);
+            }
+
+            if (l_both)
+                a_ostream << ")";
+
+        }
+
+    };
+
+    #pragma endregion
+
+    ////////////////////////////////////////////
+    //////////////// ALGORITHMS ////////////////
+    ////////////////////////////////////////////
+    #pragma region ALGORITHMS
+
+    /// Snapshots the DAGs of the argued roots. The
+    ///     snapshot's lifetime is independent of the
+    ///     source dag, which may be modified or
+    ///     destroyed afterwards. Throws for dags of
+    ///     chain nodes or truth-table leaves.
+    inline std::shared_ptr<const frozen> freeze(
+        const std::vector<const node*>& a_roots
+    )
+    {
+        forbid_chains("freeze");
+        forbid_leaves("freeze");
+
+        std::shared_ptr<frozen> l_result(new frozen());
+
+        l_result->m_entries = { { UINT32_MAX, 0, 0 }, { UINT32_MAX, 1, 1 } };
+        l_result->m_fractions = { 0.0, 1.0 };
+
+        std::map<const node*, uint32_t> l_indices = {
+            { ZERO, frozen::ZERO_INDEX },
+            { ONE, frozen::ONE_INDEX },
+        };
+
+        /// Post-order, so that each node's children
+        ///     are indexed before it.
+        std::stack<std::pair<const node*, bool>> l_stack;
+
+        for (auto l_it = a_roots.rbegin(); l_it != a_roots.rend(); l_it++)
+            l_stack.emplace(*l_it, false);
+
+        while (!l_stack.empty())
+        {
+            auto [l_node, l_expanded] = l_stack.top();
+            l_stack.pop();
+
+            if (l_indices.contains(l_node))
+                continue;
+
+            if (!l_expanded)
+            {
+                l_stack.emplace(l_node, true);
+                l_stack.emplace(l_node->positive(), false);
+                l_stack.emplace(l_node->negative(), false);
+                continue;
+            }
+
+            uint32_t l_negative = l_indices[l_node->negative()];
+            uint32_t l_positive = l_indices[l_node->positive()];
+
+            l_indices[l_node] = l_result->m_entries.size();
+
+            l_result->m_entries.push_back({ l_node->depth(), l_negative, l_positive });
+            l_result->m_fractions.push_back(
+                (l_result->m_fractions[l_negative] + l_result->m_fractions[l_positive]) / 2.0
+            );
+
+        }
+
+        for (const node* l_root : a_roots)
+            l_result->m_roots.push_back(l_indices[l_root]);
+
+        return l_result;
+
+    }
+
+    #pragma endregion
+
+}
+
+#endif
@@ -0,0 +1,59 @@
+#ifndef NETLIST_H
+#define NETLIST_H
+
+#include <string>
+#include <istream>
+
+#include "aig.h"
+
+namespace factor::aig
+{
+
+    ////////////////////////////////////////////
+    ////////////// DATA STRUCTURES /////////////
+    ////////////////////////////////////////////
+    #pragma region DATA STRUCTURES
+
+    /// A combinational circuit read from a file,
+    ///     with its named inputs and outputs.
+    struct netlist
+    {
+        graph m_graph;
+
+        std::vector<edge> m_inputs;
+        std::vector<edge> m_outputs;
+
+        std::vector<std::string> m_input_names;
+        std::vector<std::string> m_output_names;
+
+    };
+
+    #pragma endregion
+
+    ////////////////////////////////////////////
+    //////////////// ALGORITHMS ////////////////
+    ////////////////////////////////////////////
+    #pragma region ALGORITHMS
+
+    /// Reads an AIGER file, in either the ASCII (aag)
+    ///     or the binary (aig) format. Throws
+    ///     std::runtime_error for malformed input, or
+    ///     for latches, as only combinational
+    ///     circuits are supported.
+    netlist read_aiger(
+        std::istream& a_istream
+    );
+
+    /// Reads the combinational subset of BLIF, being
+    ///     .model, .inputs, .outputs, .names and .end.
+    ///     Throws std::runtime_error for malformed
+    ///     input or for any other construct.
+    netlist read_blif(
+        std::istream& a_istream
+    );
+
+    #pragma endregion
+
+}
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef REPL_H
+#define REPL_H
+
+#include <string>
+#include <istream>
+#include <ostream>
+
+#include "factor.h"
+#include "bitvector.h"
+
+namespace factor
+{
+
+    ////////////////////////////////////////////
+    ////////////// DATA STRUCTURES /////////////
+    ////////////////////////////////////////////
+    #pragma region DATA STRUCTURES
+
+    /// A line-oriented command interpreter over one
+    ///     resident dag, whose named functions and
+    ///     operation caches persist between commands,
+    ///     so that a long-lived process amortizes
+    ///     building literals, common subcircuits and
+    ///     cache entries across every query.
+    ///
+    /// Each command is one line, answered by one line,
+    ///     either "ok" followed by any result, or
+    ///     "error" followed by the reason:
+    ///
+    ///     define NAME VARIABLE[']     the literal
+    ///     parse NAME EXPRESSION       as by operator>>
+    ///     conjoin|disjoin|exor|exnor NAME X Y
+    ///     invert NAME X
+    ///     print NAME                  as by operator<<
+    ///     evaluate NAME BITS          BITS by variable
+    ///     count NAME VARIABLE_COUNT
+    ///     any_sat NAME                BITS, or "none"
+    ///     drop NAME
+    ///     stats
+    class repl
+    {
+        dag m_nodes;
+
+        std::map<std::string, const node*> m_names;
+
+        operation_cache m_operations;
+        std::map<const node*, double> m_fractions;
+
+        size_t m_commands = 0;
+
+    public:
+
+        repl(
+
+        )
+        {
+
+        }
+
+        repl(
+            const repl&
+        ) = delete;
+
+        repl& operator=(
+            const repl&
+        ) = delete;
+
+        /// Executes one command, writing its response
+        ///     line. Returns false once asked to quit.
+        bool execute(
+            const std::string& a_line,
+            std::ostream& a_ostream
+        );
+
+        /// Executes commands until the end of the
+        ///     input or until asked to quit.
+        void run(
+            std::istream& a_istream,
+            std::ostream& a_ostream
+        );
+
+    private:
+
+        const node* lookup(
+            const std::string& a_name
+        ) const;
+
+    };
+
+    #pragma endregion
+
+}
+
+#endif
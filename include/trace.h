@@ -0,0 +1,261 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <ostream>
+#include <string>
+
+/// Scoped timeline tracing of the top-level DAG
+///     operations, written in the Chrome trace
+///     event format for chrome://tracing or Perfetto.
+///
+/// The instrumentation macros below expand to nothing,
+///     evaluating none of their arguments, unless the
+///     build defines FACTOR_TRACE. The operand and
+///     result sizes cost a traversal each, so they
+///     are recorded as zero unless the build also
+///     defines FACTOR_TRACE_SIZES; the dag size delta
+///     is always recorded. A trace build writes the
+///     ring when the program exits, to the path named
+///     by FACTOR_TRACE_PATH, or else to
+///     factor-trace.json in the working directory.
+namespace factor::trace
+{
+
+    ////////////////////////////////////////////
+    ////////////// DATA STRUCTURES /////////////
+    ////////////////////////////////////////////
+    #pragma region DATA STRUCTURES
+
+    struct event
+    {
+        /// Must point to a string literal.
+        const char* m_name;
+
+        uint64_t m_start_nanoseconds;
+        uint64_t m_end_nanoseconds;
+
+        size_t m_dag_size_before;
+        size_t m_dag_size_after;
+
+        size_t m_x_size;
+        size_t m_y_size;
+        size_t m_result_size;
+
+    };
+
+    /// Holds the most recent events in a fixed ring,
+    ///     overwriting the oldest once full, so that
+    ///     recording never allocates.
+    class ring
+    {
+        static constexpr size_t CAPACITY = 1 << 16;
+
+        static inline std::array<event, CAPACITY> s_events;
+        static inline size_t s_recorded = 0;
+
+        static inline const std::chrono::steady_clock::time_point s_epoch =
+            std::chrono::steady_clock::now();
+
+    public:
+
+        static uint64_t now(
+
+        )
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - s_epoch
+            ).count();
+        }
+
+        static void record(
+            const event& a_event
+        )
+        {
+            s_events[s_recorded++ % CAPACITY] = a_event;
+        }
+
+        static size_t size(
+
+        )
+        {
+            return std::min(s_recorded, CAPACITY);
+        }
+
+        static void clear(
+
+        )
+        {
+            s_recorded = 0;
+        }
+
+        /// Writes the retained events, oldest first, as
+        ///     complete events carrying their sizes, each
+        ///     followed by a counter of the dag size.
+        static void write(
+            std::ostream& a_ostream
+        )
+        {
+            a_ostream << "{\"traceEvents\":[";
+
+            size_t l_first = s_recorded - size();
+
+            for (size_t i = l_first; i < s_recorded; i++)
+            {
+                const event& l_event = s_events[i % CAPACITY];
+
+                double l_start = l_event.m_start_nanoseconds / 1000.0;
+                double l_duration = (l_event.m_end_nanoseconds - l_event.m_start_nanoseconds) / 1000.0;
+
+                if (i != l_first)
+                    a_ostream << ",";
+
+                a_ostream
+                    << "{\"name\":\"" << l_event.m_name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":1"
+                    << ",\"ts\":" << l_start << ",\"dur\":" << l_duration
+                    << ",\"args\":{"
+                    << "\"x_size\":" << l_event.m_x_size
+                    << ",\"y_size\":" << l_event.m_y_size
+                    << ",\"result_size\":" << l_event.m_result_size
+                    << ",\"dag_delta\":" << (int64_t)(l_event.m_dag_size_after - l_event.m_dag_size_before)
+                    << "}},"
+                    << "{\"name\":\"dag size\",\"ph\":\"C\",\"pid\":1,\"tid\":1"
+                    << ",\"ts\":" << l_start + l_duration
+                    << ",\"args\":{\"nodes\":" << l_event.m_dag_size_after << "}}";
+
+            }
+
+            a_ostream << "]}";
+
+        }
+
+        static void write(
+            const std::string& a_path
+        )
+        {
+            std::ofstream l_ofstream(a_path);
+            write(l_ofstream);
+        }
+
+    };
+
+    /// Records one event spanning its own lifetime,
+    ///     including when unwound by an exception.
+    class scope
+    {
+        event m_event;
+
+    public:
+
+        scope(
+            const char* a_name,
+            size_t a_dag_size,
+            size_t a_x_size,
+            size_t a_y_size = 0
+        ) :
+            m_event{ a_name, ring::now(), 0, a_dag_size, a_dag_size, a_x_size, a_y_size, 0 }
+        {
+
+        }
+
+        scope(
+            const scope&
+        ) = delete;
+
+        scope& operator=(
+            const scope&
+        ) = delete;
+
+        void finish(
+            size_t a_dag_size,
+            size_t a_result_size
+        )
+        {
+            m_event.m_dag_size_after = a_dag_size;
+            m_event.m_result_size = a_result_size;
+        }
+
+        ~scope(
+
+        )
+        {
+            m_event.m_end_nanoseconds = ring::now();
+            ring::record(m_event);
+        }
+
+    };
+
+    /// Writes the ring to its path when destroyed,
+    ///     unless the path is empty.
+    class writer
+    {
+        std::string m_path;
+
+    public:
+
+        writer(
+            const std::string& a_path
+        ) :
+            m_path(a_path)
+        {
+
+        }
+
+        writer(
+            const writer&
+        ) = delete;
+
+        writer& operator=(
+            const writer&
+        ) = delete;
+
+        ~writer(
+
+        )
+        {
+            if (!m_path.empty())
+                ring::write(m_path);
+        }
+
+    };
+
+    #pragma endregion
+
+    ////////////////////////////////////////////
+    //////////////// GLOBAL VARS ///////////////
+    ////////////////////////////////////////////
+    #pragma region GLOBAL VARS
+
+    #ifdef FACTOR_TRACE
+
+    /// Flushes the ring during static destruction,
+    ///     after main returns or exit is called.
+    inline writer s_exit_writer(
+        std::getenv("FACTOR_TRACE_PATH") ? std::getenv("FACTOR_TRACE_PATH") : "factor-trace.json"
+    );
+
+    #endif
+
+    #pragma endregion
+
+}
+
+#ifdef FACTOR_TRACE
+    #define FACTOR_TRACE_SCOPE(scope_name, ...) factor::trace::scope scope_name(__VA_ARGS__)
+    #define FACTOR_TRACE_FINISH(scope_name, ...) scope_name.finish(__VA_ARGS__)
+#else
+    #define FACTOR_TRACE_SCOPE(scope_name, ...)
+    #define FACTOR_TRACE_FINISH(scope_name, ...)
+#endif
+
+#ifdef FACTOR_TRACE_SIZES
+    #define FACTOR_TRACE_SIZE(size) (size)
+#else
+    #define FACTOR_TRACE_SIZE(size) size_t(0)
+#endif
+
+#endif
@@ -0,0 +1,289 @@
+#ifndef ZDD_H
+#define ZDD_H
+
+#include "factor.h"
+
+/// Zero-suppressed DAGs represent families of sets
+///     over the variables, where a node's negative
+///     child holds the sets without its variable and
+///     the positive child holds the sets containing it.
+///     ZERO is the empty family, ONE is the family
+///     containing only the empty set.
+///
+/// The nodes live in the same factor::dag as ordinary
+///     DAGs, and are emplaced through the bound
+///     global_node_sink, so both kinds can coexist.
+namespace factor::zdd
+{
+
+    ////////////////////////////////////////////
+    //////////////// ALGORITHMS ////////////////
+    ////////////////////////////////////////////
+    #pragma region ALGORITHMS
+
+    /// Returns the depth of the node, treating
+    ///     the terminals as deeper than any node.
+    inline uint32_t depth(
+        const node* a_node
+    )
+    {
+        if (a_node == ZERO || a_node == ONE)
+            return UINT32_MAX;
+
+        return a_node->depth();
+
+    }
+
+    inline const node* unite(
+        std::map<std::set<const node*>, const node*>& a_cache,
+        const node* a_x,
+        const node* a_y
+    )
+    {
+        /// Uniting with the empty family
+        ///     returns the opposite operand.
+        if (a_x == ZERO)
+            return a_y;
+        if (a_y == ZERO)
+            return a_x;
+        if (a_x == a_y)
+            return a_x;
+
+        std::set<const node*> l_key = { a_x, a_y };
+
+        if (a_cache.contains(l_key))
+            return a_cache[l_key];
+
+        const node* l_result;
+
+        /// Only the shallower operand may be
+        ///     traversed, since the deeper one
+        ///     contains no sets with its variable.
+        if (depth(a_x) < depth(a_y))
+            l_result = global_node_sink::bound()->emplace_zero_suppressed(
+                a_x->depth(),
+                unite(a_cache, a_x->negative(), a_y),
+                a_x->positive()
+            );
+        else if (depth(a_y) < depth(a_x))
+            l_result = global_node_sink::bound()->emplace_zero_suppressed(
+                a_y->depth(),
+                unite(a_cache, a_x, a_y->negative()),
+                a_y->positive()
+            );
+        else
+            l_result = global_node_sink::bound()->emplace_zero_suppressed(
+                a_x->depth(),
+                unite(a_cache, a_x->negative(), a_y->negative()),
+                unite(a_cache, a_x->positive(), a_y->positive())
+            );
+
+        return a_cache[l_key] = l_result;
+
+    }
+
+    inline const node* intersect(
+        std::map<std::set<const node*>, const node*>& a_cache,
+        const node* a_x,
+        const node* a_y
+    )
+    {
+        if (a_x == ZERO || a_y == ZERO)
+            return ZERO;
+        if (a_x == a_y)
+            return a_x;
+
+        std::set<const node*> l_key = { a_x, a_y };
+
+        if (a_cache.contains(l_key))
+            return a_cache[l_key];
+
+        const node* l_result;
+
+        /// Sets containing the shallower operand's
+        ///     variable cannot be in the other family.
+        if (depth(a_x) < depth(a_y))
+            l_result = intersect(a_cache, a_x->negative(), a_y);
+        else if (depth(a_y) < depth(a_x))
+            l_result = intersect(a_cache, a_x, a_y->negative());
+        else
+            l_result = global_node_sink::bound()->emplace_zero_suppressed(
+                a_x->depth(),
+                intersect(a_cache, a_x->negative(), a_y->negative()),
+                intersect(a_cache, a_x->positive(), a_y->positive())
+            );
+
+        return a_cache[l_key] = l_result;
+
+    }
+
+    inline const node* difference(
+        std::map<std::pair<const node*, const node*>, const node*>& a_cache,
+        const node* a_x,
+        const node* a_y
+    )
+    {
+        if (a_x == ZERO || a_x == a_y)
+            return ZERO;
+        if (a_y == ZERO)
+            return a_x;
+
+        /// The key is an ordered pair, since
+        ///     the difference does not commute.
+        std::pair<const node*, const node*> l_key = { a_x, a_y };
+
+        if (a_cache.contains(l_key))
+            return a_cache[l_key];
+
+        const node* l_result;
+
+        if (depth(a_x) < depth(a_y))
+            l_result = global_node_sink::bound()->emplace_zero_suppressed(
+                a_x->depth(),
+                difference(a_cache, a_x->negative(), a_y),
+                a_x->positive()
+            );
+        else if (depth(a_y) < depth(a_x))
+            l_result = difference(a_cache, a_x, a_y->negative());
+        else
+            l_result = global_node_sink::bound()->emplace_zero_suppressed(
+                a_x->depth(),
+                difference(a_cache, a_x->negative(), a_y->negative()),
+                difference(a_cache, a_x->positive(), a_y->positive())
+            );
+
+        return a_cache[l_key] = l_result;
+
+    }
+
+    /// Toggles the membership of the argued
+    ///     variable in every set of the family. The
+    ///     cache is keyed by the variable as well, so
+    ///     it may be shared.
+    inline const node* change(
+        std::map<std::pair<const node*, uint32_t>, const node*>& a_cache,
+        const node* a_node,
+        uint32_t a_variable_index
+    )
+    {
+        if (a_node == ZERO)
+            return ZERO;
+
+        /// The variable is absent from every set,
+        ///     so it is added to all of them.
+        if (depth(a_node) > a_variable_index)
+            return global_node_sink::bound()->emplace_zero_suppressed(
+                a_variable_index,
+                ZERO,
+                a_node
+            );
+
+        /// Swap the sets with and without the variable.
+        if (a_node->depth() == a_variable_index)
+            return global_node_sink::bound()->emplace_zero_suppressed(
+                a_variable_index,
+                a_node->positive(),
+                a_node->negative()
+            );
+
+        std::pair<const node*, uint32_t> l_key = { a_node, a_variable_index };
+
+        return CACHE(
+            a_cache,
+            l_key,
+            global_node_sink::bound()->emplace_zero_suppressed(
+                a_node->depth(),
+                change(a_cache, a_node->negative(), a_variable_index),
+                change(a_cache, a_node->positive(), a_variable_index)
+            )
+        );
+
+    }
+
+    /// Converts an ordinary DAG over the first
+    ///     argued number of variables into the
+    ///     family of its satisfying assignments.
+    inline const node* from_dag(
+        std::map<std::pair<const node*, uint32_t>, const node*>& a_cache,
+        const node* a_node,
+        uint32_t a_variable_count,
+        uint32_t a_depth = 0
+    )
+    {
+        if (a_node == ZERO)
+            return ZERO;
+        if (a_depth == a_variable_count)
+            return a_node;
+
+        forbid_leaves("zdd::from_dag");
+
+        std::pair<const node*, uint32_t> l_key = { a_node, a_depth };
+
+        if (a_cache.contains(l_key))
+            return a_cache[l_key];
+
+        const node* l_negative = a_node;
+        const node* l_positive = a_node;
+
+        /// A variable skipped by the ordinary DAG
+        ///     is a don't-care, which must be made
+        ///     explicit in the zero-suppressed DAG.
+        if (a_node != ONE && a_node->depth() == a_depth)
+        {
+            l_negative = global_node_sink::bound()->negative(a_node);
+            l_positive = global_node_sink::bound()->positive(a_node);
+        }
+
+        return a_cache[l_key] = global_node_sink::bound()->emplace_zero_suppressed(
+            a_depth,
+            from_dag(a_cache, l_negative, a_variable_count, a_depth + 1),
+            from_dag(a_cache, l_positive, a_variable_count, a_depth + 1)
+        );
+
+    }
+
+    /// Converts a family of sets over the first
+    ///     argued number of variables into the
+    ///     ordinary DAG of its characteristic function.
+    inline const node* to_dag(
+        std::map<std::pair<const node*, uint32_t>, const node*>& a_cache,
+        const node* a_node,
+        uint32_t a_variable_count,
+        uint32_t a_depth = 0
+    )
+    {
+        if (a_node == ZERO)
+            return ZERO;
+        if (a_depth == a_variable_count)
+            return a_node;
+
+        std::pair<const node*, uint32_t> l_key = { a_node, a_depth };
+
+        if (a_cache.contains(l_key))
+            return a_cache[l_key];
+
+        const node* l_negative = a_node;
+        const node* l_positive = ZERO;
+
+        /// A variable skipped by the zero-suppressed
+        ///     DAG is absent from every set, so it
+        ///     must be false in the ordinary DAG.
+        if (a_node != ONE && a_node->depth() == a_depth)
+        {
+            l_negative = a_node->negative();
+            l_positive = a_node->positive();
+        }
+
+        return a_cache[l_key] = global_node_sink::bound()->emplace(
+            a_depth,
+            to_dag(a_cache, l_negative, a_variable_count, a_depth + 1),
+            to_dag(a_cache, l_positive, a_variable_count, a_depth + 1)
+        );
+
+    }
+
+    #pragma endregion
+
+}
+
+#endif
@@ -1,8 +1,23 @@
 #include <iostream>
 #include <assert.h>
 #include <sstream>
+#include <filesystem>
+#include <random>
 
 #include "include/factor.h"
+#include "include/zdd.h"
+#include "include/add.h"
+#include "include/bitvector.h"
+#include "include/approximation.h"
+#include "include/external.h"
+#include "include/arena.h"
+#include "include/frozen.h"
+#include "include/constraint.h"
+#include "include/netlist.h"
+#include "include/equivalence.h"
+#include "include/repl.h"
+#include "include/checkpoint.h"
+#include "include/codegen.h"
 
 #define LOG(x) if (ENABLE_DEBUG_LOGS) std::cout << x;
 
@@ -1283,6 +1298,2458 @@ void test_node_istream_extractor(
 
 }
 
+void test_zdd(
+
+)
+{
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    std::map<std::pair<const node*, uint32_t>, const node*> l_change_cache;
+    std::map<std::set<const node*>, const node*> l_unite_cache;
+    std::map<std::set<const node*>, const node*> l_intersect_cache;
+    std::map<std::pair<const node*, const node*>, const node*> l_difference_cache;
+
+    /// Construct the singleton families {{0}}, {{1}} and {{0, 1}}.
+    const node* l_0 = zdd::change(l_change_cache, ONE, 0);
+    const node* l_1 = zdd::change(l_change_cache, ONE, 1);
+    const node* l_01 = zdd::change(l_change_cache, l_0, 1);
+
+    /// A singleton family is a single chain with no
+    ///     don't-care nodes, unlike its ordinary DAG.
+    assert(l_01->depth() == 0);
+    assert(l_01->negative() == ZERO);
+    assert(l_01->positive()->depth() == 1);
+    assert(l_01->positive()->negative() == ZERO);
+    assert(l_01->positive()->positive() == ONE);
+
+    const node* l_family = zdd::unite(l_unite_cache, l_0, zdd::unite(l_unite_cache, l_1, l_01));
+
+    /// Union is commutative and idempotent.
+    assert(zdd::unite(l_unite_cache, l_01, zdd::unite(l_unite_cache, l_1, l_0)) == l_family);
+    assert(zdd::unite(l_unite_cache, l_family, l_0) == l_family);
+
+    assert(zdd::intersect(l_intersect_cache, l_family, l_1) == l_1);
+    assert(zdd::intersect(l_intersect_cache, l_0, l_1) == ZERO);
+    assert(zdd::intersect(l_intersect_cache, l_family, ONE) == ZERO);
+
+    assert(zdd::difference(l_difference_cache, l_family, l_family) == ZERO);
+    assert(zdd::difference(l_difference_cache, l_family, l_1) == zdd::unite(l_unite_cache, l_0, l_01));
+    assert(zdd::difference(l_difference_cache, l_0, l_family) == ZERO);
+
+    /// Toggling variable 1 maps {{0}, {1}, {0, 1}} to {{0, 1}, {}, {0}}.
+    assert(zdd::change(l_change_cache, l_family, 1) == zdd::unite(l_unite_cache, ONE, zdd::unite(l_unite_cache, l_0, l_01)));
+
+    /// The family is exactly the satisfying assignments of
+    ///     a disjunction over two variables.
+    std::map<std::pair<const node*, uint32_t>, const node*> l_conversion_cache;
+
+    const node* l_disjunction = disjoin(literal(0, true), literal(1, true));
+
+    assert(zdd::from_dag(l_conversion_cache, l_disjunction, 2) == l_family);
+
+    l_conversion_cache.clear();
+
+    assert(zdd::to_dag(l_conversion_cache, l_family, 2) == l_disjunction);
+
+    l_conversion_cache.clear();
+
+    /// Round trip a larger function over six variables.
+    const node* l_function =
+        conjoin(literal(0, true), disjoin(literal(2, false), literal(3, true)), invert(conjoin(literal(4, true), literal(5, true))));
+
+    const node* l_zdd = zdd::from_dag(l_conversion_cache, l_function, 6);
+
+    l_conversion_cache.clear();
+
+    assert(zdd::to_dag(l_conversion_cache, l_zdd, 6) == l_function);
+
+}
+
+void test_add(
+
+)
+{
+    dag l_nodes;
+    add::dag<int64_t> l_int_nodes;
+    add::dag<double> l_double_nodes;
+
+    global_node_sink::bind(&l_nodes);
+    add::global_node_sink<int64_t>::bind(&l_int_nodes);
+    add::global_node_sink<double>::bind(&l_double_nodes);
+
+    /// Terminals are contracted by value.
+    assert(add::constant<int64_t>(7) == add::constant<int64_t>(7));
+    assert(add::constant<int64_t>(7) != add::constant<int64_t>(8));
+    assert(l_int_nodes.size() == 2);
+
+    std::list<const node*> l_p = { literal(0, true), literal(1, true), literal(2, true) };
+    std::list<const node*> l_q = { literal(3, true), literal(4, true), literal(5, true) };
+
+    /// Build p * q as a single arithmetic DAG.
+    const add::node<int64_t>* l_product =
+        add::product(add::from_bits<int64_t>(l_p), add::from_bits<int64_t>(l_q));
+
+    for (int i = 0; i < 64; i++)
+    {
+        std::vector<bool> l_input;
+
+        for (int j = 0; j < 6; j++)
+            l_input.push_back((i & (0x1 << j)) != 0);
+
+        assert(add::evaluate(l_product, l_input) == (i & 0x7) * (i >> 3));
+
+    }
+
+    /// The threshold at 15 must be the same
+    ///     canonical DAG as the bitwise product.
+    std::map<std::tuple<const add::node<int64_t>*, add::comparison, int64_t>, const node*> l_compare_cache;
+
+    const node* l_equal = add::compare(l_compare_cache, l_product, add::comparison::EQUAL, (int64_t)15);
+
+    const std::list<const node*> l_desired_output = { ONE, ONE, ONE, ONE, ZERO, ZERO };
+
+    assert(l_equal == exnor(multiply(l_p, l_q), l_desired_output));
+
+    /// Only 0 * 0 has a product below one, through
+    ///     the cache shared with the comparison above.
+    assert(
+        add::compare(l_compare_cache, l_product, add::comparison::LESS, (int64_t)1) ==
+        disjoin(conjoin(literal(0, false), literal(1, false), literal(2, false)),
+                conjoin(literal(3, false), literal(4, false), literal(5, false)))
+    );
+
+    /// Test max and min over doubles.
+    std::map<const node*, const add::node<double>*> l_conversion_cache;
+
+    const add::node<double>* l_a = add::from_dag<double>(l_conversion_cache, literal(0, true));
+    const add::node<double>* l_b =
+        add::sum(add::product(add::from_dag<double>(l_conversion_cache, literal(1, true)), add::constant(0.5)), add::constant(0.25));
+
+    const add::node<double>* l_max = add::maximum(l_a, l_b);
+    const add::node<double>* l_min = add::minimum(l_a, l_b);
+
+    assert(add::evaluate(l_max, { 0, 0 }) == 0.25);
+    assert(add::evaluate(l_max, { 0, 1 }) == 0.75);
+    assert(add::evaluate(l_max, { 1, 0 }) == 1.0);
+    assert(add::evaluate(l_min, { 1, 1 }) == 0.75);
+    assert(add::evaluate(l_min, { 0, 1 }) == 0.0);
+
+}
+
+void test_bitvector(
+
+)
+{
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    operation_cache l_cache;
+
+    bitvector<3> l_x = bitvector<3>::variables(0);
+    bitvector<3> l_y = bitvector<3>::variables(3);
+
+    bitvector<3> l_sum = sum(l_cache, l_x, l_y);
+    bitvector<3> l_difference = difference(l_cache, l_x, l_y);
+    bitvector<6> l_product = product(l_cache, l_x, l_y);
+    const node* l_less = less(l_cache, l_x, l_y);
+    const node* l_equal = equal(l_cache, l_x, l_y);
+    const node* l_equal_5 = equal(l_cache, l_x, 5);
+
+    const auto l_value = [](const auto& a_bits, const std::vector<bool>& a_input)
+    {
+        int l_result = 0;
+
+        for (size_t i = 0; i < a_bits.size(); i++)
+            l_result |= evaluate(a_bits[i], a_input) << i;
+
+        return l_result;
+
+    };
+
+    for (int i = 0; i < 64; i++)
+    {
+        std::vector<bool> l_input;
+
+        for (int j = 0; j < 6; j++)
+            l_input.push_back((i & (0x1 << j)) != 0);
+
+        int l_a = i & 0x7;
+        int l_b = i >> 3;
+
+        assert(l_value(l_sum, l_input) == ((l_a + l_b) & 0x7));
+        assert(l_value(l_difference, l_input) == ((l_a - l_b) & 0x7));
+        assert(l_value(l_product, l_input) == l_a * l_b);
+        assert(evaluate(l_less, l_input) == (l_a < l_b));
+        assert(evaluate(l_equal, l_input) == (l_a == l_b));
+        assert(evaluate(l_equal_5, l_input) == (l_a == 5));
+
+    }
+
+    /// The carry-save product must agree, node for node,
+    ///     with the generic multiply from digital-logic.
+    bitvector<12> l_wide_product =
+        product(l_cache, bitvector<6>::variables(0), bitvector<6>::variables(6));
+
+    std::list<const node*> l_bits_0;
+    std::list<const node*> l_bits_1;
+
+    for (uint32_t i = 0; i < 6; i++)
+    {
+        l_bits_0.push_back(literal(i, true));
+        l_bits_1.push_back(literal(i + 6, true));
+    }
+
+    std::list<const node*> l_generic_product = multiply(l_bits_0, l_bits_1);
+
+    size_t l_index = 0;
+
+    for (const node* l_bit : l_generic_product)
+        assert(l_bit == l_wide_product[l_index++]);
+
+    /// Constants are folded entirely at build time.
+    bitvector<8> l_constant_product = product(l_cache, bitvector<4>::constant(13), bitvector<4>::constant(11));
+
+    for (size_t i = 0; i < 8; i++)
+        assert(l_constant_product[i] == ((143 >> i) & 0x1 ? ONE : ZERO));
+
+    bitvector<3> l_shifted_left = shift_left(l_x, 1);
+    bitvector<3> l_shifted_right = shift_right(l_x, 2);
+
+    assert(l_shifted_left[0] == ZERO);
+    assert(l_shifted_left[1] == l_x[0]);
+    assert(l_shifted_left[2] == l_x[1]);
+    assert(l_shifted_right[0] == l_x[2]);
+    assert(l_shifted_right[1] == ZERO);
+    assert(l_shifted_right[2] == ZERO);
+
+}
+
+void test_dag_budget(
+
+)
+{
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    std::list<const node*> l_bits_0;
+    std::list<const node*> l_bits_1;
+
+    for (uint32_t i = 0; i < 6; i++)
+    {
+        l_bits_0.push_back(literal(i, true));
+        l_bits_1.push_back(literal(i + 6, true));
+    }
+
+    std::vector<const node*> l_roots(l_bits_0.begin(), l_bits_0.end());
+    l_roots.insert(l_roots.end(), l_bits_1.begin(), l_bits_1.end());
+
+    bool l_pressured = false;
+
+    budget l_budget;
+    l_budget.m_node_limit = 500;
+    l_budget.m_pressure_node_count = 400;
+    l_budget.m_pressure = [&l_pressured](dag& a_dag)
+    {
+        assert(a_dag.size() == 400);
+        l_pressured = true;
+    };
+
+    l_nodes.limit(l_budget);
+
+    /// The product is far larger than the limit.
+    try
+    {
+        multiply(l_bits_0, l_bits_1);
+        assert(false);
+    }
+    catch (const budget_exceeded& a_exception)
+    {
+        assert(a_exception.m_reason == budget_exceeded::reason::NODES);
+    }
+
+    assert(l_pressured);
+    assert(l_nodes.size() == 500);
+
+    /// Existing nodes may still be emplaced at the limit.
+    assert(literal(0, true) == l_roots[0]);
+
+    /// The partial results are reclaimable.
+    assert(l_nodes.collect(l_roots) == 500 - 12);
+    assert(l_nodes.size() == 12);
+
+    /// The dag stays usable after the abort.
+    l_nodes.limit(budget());
+
+    const node* l_function = conjoin(l_roots[0], disjoin(l_roots[1], l_roots[2]));
+
+    assert(evaluate(l_function, { 1, 0, 1 }));
+    assert(!evaluate(l_function, { 0, 1, 1 }));
+
+    /// Test the byte limit.
+    l_budget = budget();
+    l_budget.m_byte_limit = l_nodes.bytes() + 10 * (l_nodes.bytes() / l_nodes.size());
+    l_nodes.limit(l_budget);
+
+    try
+    {
+        multiply(l_bits_0, l_bits_1);
+        assert(false);
+    }
+    catch (const budget_exceeded& a_exception)
+    {
+        assert(a_exception.m_reason == budget_exceeded::reason::BYTES);
+    }
+
+    assert(l_nodes.bytes() <= l_budget.m_byte_limit);
+
+    /// Test the deadline, which has already passed.
+    l_budget = budget();
+    l_budget.m_deadline = std::chrono::steady_clock::now();
+    l_nodes.limit(l_budget);
+
+    try
+    {
+        multiply(l_bits_0, l_bits_1);
+        assert(false);
+    }
+    catch (const budget_exceeded& a_exception)
+    {
+        assert(a_exception.m_reason == budget_exceeded::reason::DEADLINE);
+    }
+
+    /// The callback may relax the budget it was
+    ///     installed by, replacing itself.
+    l_nodes.collect(l_roots);
+
+    std::vector<size_t> l_steps = { 100000, 50000, 20000 };
+    size_t l_relaxed = 0;
+
+    l_budget = budget();
+    l_budget.m_node_limit = 100;
+    l_budget.m_pressure_node_count = 50;
+    l_budget.m_pressure = [l_steps, &l_relaxed](dag& a_dag)
+    {
+        budget l_relief;
+        l_relief.m_node_limit = l_steps[0];
+
+        a_dag.limit(l_relief);
+
+        /// The captures must outlive the replacement.
+        l_relaxed = l_steps[0] + l_steps[1] + l_steps[2];
+    };
+
+    l_nodes.limit(l_budget);
+
+    multiply(l_bits_0, l_bits_1);
+
+    assert(l_relaxed == 170000);
+    assert(l_nodes.limits().m_node_limit == 100000);
+    assert(!l_nodes.limits().m_pressure);
+
+}
+
+void test_approximation(
+
+)
+{
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    std::list<const node*> l_bits_0;
+    std::list<const node*> l_bits_1;
+
+    for (uint32_t i = 0; i < 5; i++)
+    {
+        l_bits_0.push_back(literal(i, true));
+        l_bits_1.push_back(literal(i + 5, true));
+    }
+
+    /// The constraint that the product exceeds 255.
+    std::list<const node*> l_product = multiply(l_bits_0, l_bits_1);
+
+    const node* l_function = disjoin(*std::next(l_product.begin(), 8), *std::next(l_product.begin(), 9));
+
+    size_t l_size = node_count(l_function);
+    double l_count = count(l_function, 10);
+
+    assert(l_size > 20);
+
+    /// Each approximation must imply the original,
+    ///     and fit within the threshold.
+    const auto l_check = [&](const node* a_subset, size_t a_threshold)
+    {
+        assert(node_count(a_subset) <= a_threshold);
+        assert(a_subset != ZERO);
+        assert(conjoin(a_subset, invert(l_function)) == ZERO);
+        assert(count(a_subset, 10) <= l_count);
+    };
+
+    for (size_t l_threshold : { l_size / 2, l_size / 4, (size_t)10 })
+    {
+        l_check(subset_heavy_branch(l_function, l_threshold), l_threshold);
+        l_check(subset_short_paths(l_function, l_threshold), l_threshold);
+        l_check(subset_remap(l_function, l_threshold), l_threshold);
+    }
+
+    /// A function within the threshold is returned as is.
+    assert(subset_heavy_branch(l_function, l_size) == l_function);
+    assert(subset_short_paths(l_function, l_size) == l_function);
+    assert(subset_remap(l_function, l_size) == l_function);
+
+    /// Nothing fits within a threshold of zero.
+    assert(subset_heavy_branch(l_function, 0) == ZERO);
+    assert(subset_short_paths(l_function, 0) == ZERO);
+    assert(subset_remap(l_function, 0) == ZERO);
+
+    /// The heavy branch keeps the larger half.
+    const node* l_skewed = disjoin(literal(0, true), conjoin(literal(1, true), literal(2, true)));
+
+    assert(subset_heavy_branch(l_skewed, 1) == literal(0, true));
+
+}
+
+void test_dag_logic_apply(
+
+)
+{
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    const node* l_a = literal(0, true);
+    const node* l_b = literal(1, true);
+    const node* l_c = literal(2, true);
+
+    const node* l_functions[] = {
+        ZERO,
+        ONE,
+        l_a,
+        invert(l_b),
+        disjoin(l_a, l_c),
+        conjoin(l_b, invert(l_c)),
+        exor(l_a, l_b, l_c),
+    };
+
+    std::map<std::tuple<operation, const node*, const node*>, const node*> l_cache;
+
+    /// Check every operation against its truth
+    ///     table, over every pair of functions.
+    for (uint8_t l_code = 0; l_code < 16; l_code++)
+        for (const node* l_x : l_functions)
+            for (const node* l_y : l_functions)
+            {
+                const node* l_result = apply(l_cache, (operation)l_code, l_x, l_y);
+
+                for (int i = 0; i < 8; i++)
+                {
+                    std::vector<bool> l_input = { (i & 0x1) != 0, (i & 0x2) != 0, (i & 0x4) != 0 };
+
+                    bool l_x_value = evaluate(l_x, l_input);
+                    bool l_y_value = evaluate(l_y, l_input);
+
+                    assert(evaluate(l_result, l_input) == ((l_code >> (2 * l_x_value + l_y_value) & 0x1) != 0));
+
+                }
+
+            }
+
+    l_cache.clear();
+
+    /// The results are canonical, so they must be
+    ///     identical to those of join and invert.
+    assert(apply(l_cache, operation::AND, l_a, l_functions[4]) == conjoin(l_a, l_functions[4]));
+    assert(apply(l_cache, operation::OR, l_b, l_functions[5]) == disjoin(l_b, l_functions[5]));
+    assert(apply(l_cache, operation::NAND, l_a, l_c) == invert(conjoin(l_a, l_c)));
+    assert(apply(l_cache, operation::IMPLICATION, l_a, l_c) == disjoin(invert(l_a), l_c));
+
+    l_cache.clear();
+
+    /// Commutative operations share cache entries
+    ///     regardless of the operand order.
+    apply(l_cache, operation::XOR, l_a, l_b);
+
+    size_t l_cache_size = l_cache.size();
+
+    apply(l_cache, operation::XOR, l_b, l_a);
+
+    assert(l_cache.size() == l_cache_size);
+
+    /// Non-commutative operations do not.
+    apply(l_cache, operation::NONIMPLICATION, l_a, l_b);
+
+    l_cache_size = l_cache.size();
+
+    apply(l_cache, operation::NONIMPLICATION, l_b, l_a);
+
+    assert(l_cache.size() > l_cache_size);
+
+    /// The logic specializations build in one traversal.
+    assert(exor(l_a, l_b) == disjoin(conjoin(l_a, invert(l_b)), conjoin(invert(l_a), l_b)));
+    assert(exnor(l_a, l_b) == invert(exor(l_a, l_b)));
+
+}
+
+void test_logic_routing(
+
+)
+{
+    std::map<std::tuple<operation, const node*, const node*>, const node*> l_cache;
+
+    /// The reference DAGs are built by apply alone,
+    ///     so that any node emplaced by a generic
+    ///     decomposition shows up as a larger DAG.
+    dag l_reference;
+
+    global_node_sink::bind(&l_reference);
+
+    const node* l_x = literal(0, true);
+    const node* l_y = literal(1, true);
+    const node* l_z = literal(2, true);
+
+    apply(l_cache, operation::XOR, apply(l_cache, operation::XOR, l_x, l_y), l_z);
+
+    size_t l_exor_size = l_reference.size();
+
+    dag l_pairs;
+
+    global_node_sink::bind(&l_pairs);
+
+    apply(l_cache, operation::XNOR, literal(0, true), literal(1, true));
+
+    size_t l_exnor_size = l_pairs.size();
+
+    dag l_product;
+
+    global_node_sink::bind(&l_product);
+
+    conjoin(literal(0, true), literal(1, true));
+
+    size_t l_product_size = l_product.size();
+
+    /// The three-input exor of every full adder.
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    const node* l_a = literal(0, true);
+    const node* l_b = literal(1, true);
+    const node* l_c = literal(2, true);
+
+    const node* l_sum = logic::exor(l_a, l_b, l_c);
+
+    assert(l_nodes.size() == l_exor_size);
+
+    for (int i = 0; i < 8; i++)
+    {
+        std::vector<bool> l_input = { (i & 0x1) != 0, (i & 0x2) != 0, (i & 0x4) != 0 };
+        assert(evaluate(l_sum, l_input) == (l_input[0] != l_input[1] != l_input[2]));
+    }
+
+    /// The comparison of words reaches exnor.
+    dag l_compared;
+
+    global_node_sink::bind(&l_compared);
+
+    const node* l_equal = logic::exnor(
+        std::list<const node*>{ literal(0, true) },
+        std::list<const node*>{ literal(1, true) }
+    );
+
+    assert(l_compared.size() == l_exnor_size);
+    assert(evaluate(l_equal, { true, true }) && !evaluate(l_equal, { true, false }));
+
+    /// The adders of multiply reach exor, which must
+    ///     not emplace the inversions of the products.
+    dag l_multiplied;
+
+    global_node_sink::bind(&l_multiplied);
+
+    std::list<const node*> l_bits = logic::multiply(
+        std::list<const node*>{ literal(0, true) },
+        std::list<const node*>{ literal(1, true) }
+    );
+
+    assert(l_multiplied.size() == l_product_size);
+    assert(l_bits.front() == conjoin(literal(0, true), literal(1, true)));
+
+    global_node_sink::bind(nullptr);
+
+}
+
+void test_predicates(
+
+)
+{
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    const node* l_a = literal(0, true);
+    const node* l_b = literal(1, true);
+    const node* l_c = literal(2, true);
+
+    const node* l_a_and_b = conjoin(l_a, l_b);
+    const node* l_a_or_c = disjoin(l_a, l_c);
+    const node* l_a_bar = invert(l_a);
+    const node* l_a_bar_and_c_bar = conjoin(l_a_bar, invert(l_c));
+
+    size_t l_size = l_nodes.size();
+
+    std::set<std::pair<const node*, const node*>> l_cache;
+
+    assert(is_disjoint(l_cache, l_a_or_c, l_a_bar_and_c_bar));
+    assert(is_disjoint(l_cache, ZERO, l_a));
+    assert(!is_disjoint(l_cache, l_a_and_b, l_a_or_c));
+    assert(!is_disjoint(l_cache, l_b, l_a_bar_and_c_bar));
+    assert(!is_disjoint(l_cache, ONE, l_a));
+
+    l_cache.clear();
+
+    assert(implies(l_cache, l_a_and_b, l_a_or_c));
+    assert(implies(l_cache, l_a_and_b, l_b));
+    assert(implies(l_cache, ZERO, l_a));
+    assert(implies(l_cache, l_a, ONE));
+    assert(!implies(l_cache, l_a_or_c, l_a_and_b));
+    assert(!implies(l_cache, l_b, l_a_and_b));
+    assert(!implies(l_cache, ONE, l_a));
+
+    std::set<std::tuple<const node*, const node*, const node*>> l_triple_cache;
+
+    /// Under a, (a and b) agrees with b, and (a or c) with one.
+    assert(equal_under(l_triple_cache, l_a_and_b, l_b, l_a));
+    assert(equal_under(l_triple_cache, l_a_or_c, ONE, l_a));
+    assert(equal_under(l_triple_cache, l_a, l_b, ZERO));
+    assert(!equal_under(l_triple_cache, l_a_and_b, l_b, ONE));
+    assert(!equal_under(l_triple_cache, l_a_or_c, l_c, l_a));
+    assert(equal_under(l_triple_cache, l_a_or_c, l_c, l_a_bar));
+
+    /// None of the queries have grown the dag.
+    assert(l_nodes.size() == l_size);
+
+}
+
+void test_constrain(
+
+)
+{
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    const node* l_a = literal(0, true);
+    const node* l_b = literal(1, true);
+    const node* l_c = literal(2, true);
+    const node* l_d = literal(3, true);
+
+    const node* l_functions[] = {
+        ZERO,
+        ONE,
+        l_d,
+        conjoin(l_a, l_b, l_d),
+        exor(l_a, l_c, l_d),
+        disjoin(conjoin(l_a, l_b), conjoin(l_c, l_d)),
+    };
+
+    const node* l_cares[] = {
+        ONE,
+        l_a,
+        conjoin(l_a, l_b),
+        disjoin(l_b, l_c),
+        exor(l_a, l_d),
+    };
+
+    std::map<std::pair<const node*, const node*>, const node*> l_constraints;
+    std::map<std::pair<const node*, const node*>, const node*> l_restrictions;
+    std::map<std::tuple<operation, const node*, const node*>, const node*> l_applications;
+
+    /// Both results must agree with the function
+    ///     wherever the care function holds.
+    for (const node* l_function : l_functions)
+        for (const node* l_care : l_cares)
+        {
+            const node* l_constrained = constrain(l_constraints, l_function, l_care);
+            const node* l_restricted = restrict(l_restrictions, l_applications, l_function, l_care);
+
+            for (int i = 0; i < 16; i++)
+            {
+                std::vector<bool> l_input = { (i & 0x1) != 0, (i & 0x2) != 0, (i & 0x4) != 0, (i & 0x8) != 0 };
+
+                if (!evaluate(l_care, l_input))
+                    continue;
+
+                assert(evaluate(l_constrained, l_input) == evaluate(l_function, l_input));
+                assert(evaluate(l_restricted, l_input) == evaluate(l_function, l_input));
+
+            }
+
+        }
+
+    /// The variables fixed by the care function vanish.
+    assert(constrain(l_functions[3], l_functions[3]) == ONE);
+    assert(constrain(l_functions[3], l_cares[2]) == l_d);
+    assert(restrict(l_functions[3], l_cares[2]) == l_d);
+    assert(constrain(l_functions[5], l_cares[2]) == ONE);
+
+    /// Restrict never introduces variables absent
+    ///     from the function, whereas constrain may.
+    assert(restrict(l_d, l_cares[4]) == l_d);
+    assert(constrain(l_d, l_cares[4]) == invert(l_a));
+
+}
+
+void test_permute(
+
+)
+{
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    const node* l_a = literal(0, true);
+    const node* l_b = literal(1, true);
+    const node* l_c = literal(2, true);
+
+    /// A template circuit over the first three variables.
+    const node* l_template = disjoin(conjoin(l_a, l_b), exor(l_b, l_c));
+
+    std::map<const node*, const node*> l_cache;
+
+    /// Shifting copies the structure node for node.
+    size_t l_size = l_nodes.size();
+
+    const node* l_shifted = shift(l_cache, l_template, 5);
+
+    assert(l_nodes.size() == l_size + node_count(l_template));
+    assert(support(l_shifted) == std::set<uint32_t>({ 5, 6, 7 }));
+
+    assert(
+        l_shifted ==
+        disjoin(
+            conjoin(literal(5, true), literal(6, true)),
+            exor(literal(6, true), literal(7, true))
+        )
+    );
+
+    std::map<std::tuple<operation, const node*, const node*>, const node*> l_applications;
+
+    /// An order-preserving mapping agrees with shift.
+    l_cache.clear();
+
+    assert(permute(l_cache, l_applications, { { 0, 5 }, { 1, 6 }, { 2, 7 } }, l_template) == l_shifted);
+
+    /// Reversing the variables needs the general path.
+    l_cache.clear();
+
+    const node* l_reversed = permute(l_cache, l_applications, { { 0, 2 }, { 2, 0 } }, l_template);
+
+    assert(l_reversed == disjoin(conjoin(l_c, l_b), exor(l_b, l_a)));
+
+    for (int i = 0; i < 8; i++)
+    {
+        std::vector<bool> l_input = { (i & 0x1) != 0, (i & 0x2) != 0, (i & 0x4) != 0 };
+        std::vector<bool> l_reversed_input = { l_input[2], l_input[1], l_input[0] };
+
+        assert(evaluate(l_reversed, l_input) == evaluate(l_template, l_reversed_input));
+
+    }
+
+    /// Merging two variables is also handled.
+    l_cache.clear();
+
+    assert(permute(l_cache, l_applications, { { 2, 1 } }, l_template) == disjoin(conjoin(l_a, l_b), ZERO));
+
+}
+
+void test_join_breadth_first(
+
+)
+{
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    const node* l_a = literal(0, true);
+    const node* l_b = literal(1, true);
+    const node* l_c = literal(2, true);
+    const node* l_d = literal(3, true);
+
+    const node* l_functions[] = {
+        ZERO,
+        ONE,
+        l_a,
+        invert(l_d),
+        exor(l_a, l_b, l_c, l_d),
+        disjoin(conjoin(l_a, l_b), conjoin(l_c, l_d)),
+        conjoin(disjoin(l_a, invert(l_c)), exor(l_b, l_d)),
+    };
+
+    /// The results are canonical, so both engines
+    ///     must produce the very same nodes.
+    for (const node* l_x : l_functions)
+        for (const node* l_y : l_functions)
+        {
+            std::map<std::set<const node*>, const node*> l_cache;
+
+            assert(join_breadth_first(ZERO, ONE, l_x, l_y) == factor::join(l_cache, ZERO, ONE, l_x, l_y));
+
+            l_cache.clear();
+
+            assert(join_breadth_first(ONE, ZERO, l_x, l_y) == factor::join(l_cache, ONE, ZERO, l_x, l_y));
+
+        }
+
+    /// The engine is selected behind logic::join.
+    const node* l_depth_first = conjoin(l_functions[4], l_functions[5], l_functions[6]);
+
+    global_join_engine::bind(join_engine::BREADTH_FIRST);
+
+    assert(conjoin(l_functions[4], l_functions[5], l_functions[6]) == l_depth_first);
+    assert(disjoin(l_functions[4], l_functions[6]) == invert(conjoin(invert(l_functions[4]), invert(l_functions[6]))));
+
+    global_join_engine::bind(join_engine::DEPTH_FIRST);
+
+}
+
+void test_external(
+
+)
+{
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    const node* l_a = literal(0, true);
+    const node* l_b = literal(1, true);
+    const node* l_c = literal(2, true);
+    const node* l_d = literal(3, true);
+
+    const node* l_x = disjoin(conjoin(l_a, l_b), conjoin(l_c, l_d));
+    const node* l_y = exor(l_a, l_c, l_d);
+
+    std::string l_directory = std::filesystem::temp_directory_path().string();
+
+    std::string l_x_path = l_directory + "/factor_test_x.dag";
+    std::string l_y_path = l_directory + "/factor_test_y.dag";
+    std::string l_output_path = l_directory + "/factor_test_output.dag";
+
+    external::from_dag(l_x, l_x_path);
+    external::from_dag(l_y, l_y_path);
+
+    /// Round trips preserve the function exactly.
+    assert(external::to_dag(l_x_path) == l_x);
+    assert(external::to_dag(l_y_path) == l_y);
+
+    external::from_dag(ONE, l_output_path);
+    assert(external::to_dag(l_output_path) == ONE);
+
+    external::invert(l_x_path, l_output_path);
+    assert(external::to_dag(l_output_path) == invert(l_x));
+
+    /// Every operation agrees with the in-memory apply.
+    std::map<std::tuple<operation, const node*, const node*>, const node*> l_cache;
+
+    for (uint8_t l_code = 0; l_code < 16; l_code++)
+    {
+        external::apply((operation)l_code, l_x_path, l_y_path, l_output_path);
+        assert(external::to_dag(l_output_path) == apply(l_cache, (operation)l_code, l_x, l_y));
+    }
+
+    /// Restricting a = 1 and c = 0 leaves b.
+    external::restrict(l_x_path, { { 0, true }, { 2, false } }, l_output_path);
+    assert(external::to_dag(l_output_path) == l_b);
+
+    external::restrict(l_y_path, { { 3, true } }, l_output_path);
+    assert(external::to_dag(l_output_path) == invert(exor(l_a, l_c)));
+
+    assert(external::sat_count(l_x_path, 4) == count(l_x, 4));
+    assert(external::sat_count(l_y_path, 6) == 32);
+
+    /// Writing over an input is refused, and leaves
+    ///     the input intact.
+    bool l_thrown = false;
+
+    try { external::invert(l_x_path, l_x_path); } catch (const std::runtime_error&) { l_thrown = true; }
+
+    assert(l_thrown);
+    assert(external::to_dag(l_x_path) == l_x);
+
+    l_thrown = false;
+
+    try { external::apply(operation::AND, l_x_path, l_y_path, l_y_path); } catch (const std::runtime_error&) { l_thrown = true; }
+
+    assert(l_thrown);
+    assert(external::to_dag(l_y_path) == l_y);
+
+    std::filesystem::remove(l_x_path);
+    std::filesystem::remove(l_y_path);
+    std::filesystem::remove(l_output_path);
+
+}
+
+void test_compact(
+
+)
+{
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    const node* l_a = literal(0, true);
+    const node* l_b = literal(1, true);
+    const node* l_c = literal(2, true);
+    const node* l_d = literal(3, true);
+
+    /// Intermediate results become garbage.
+    exor(l_a, l_b, l_c, l_d);
+    disjoin(conjoin(l_a, l_c), invert(l_d));
+
+    const node* l_x = disjoin(conjoin(l_a, l_b), conjoin(l_c, l_d));
+    const node* l_y = conjoin(l_x, invert(l_b));
+
+    std::stringstream l_x_expected;
+    std::stringstream l_y_expected;
+
+    l_x_expected << l_x;
+    l_y_expected << l_y;
+
+    for (layout l_layout : { layout::DEPTH_FIRST, layout::LEVEL })
+    {
+        dag l_compacted;
+
+        std::vector<const node*> l_roots = compact(l_compacted, { l_x, l_y, ONE }, l_layout);
+
+        /// Only the reachable nodes are copied.
+        std::set<const node*> l_reachable;
+
+        for (const node* l_root : { l_x, l_y })
+        {
+            std::stack<const node*> l_stack;
+
+            l_stack.push(l_root);
+
+            while (!l_stack.empty())
+            {
+                const node* l_node = l_stack.top();
+                l_stack.pop();
+
+                if (l_node == ZERO || l_node == ONE || !l_reachable.insert(l_node).second)
+                    continue;
+
+                l_stack.push(l_node->negative());
+                l_stack.push(l_node->positive());
+
+            }
+
+        }
+
+        assert(l_compacted.size() == l_reachable.size());
+        assert(l_compacted.size() < l_nodes.size());
+
+        assert(l_roots.size() == 3);
+        assert(l_roots[2] == ONE);
+
+        std::stringstream l_x_actual;
+        std::stringstream l_y_actual;
+
+        l_x_actual << l_roots[0];
+        l_y_actual << l_roots[1];
+
+        assert(l_x_actual.str() == l_x_expected.str());
+        assert(l_y_actual.str() == l_y_expected.str());
+
+    }
+
+}
+
+void test_dag_memory_resource(
+
+)
+{
+    std::string l_expected;
+
+    {
+        dag l_nodes;
+
+        global_node_sink::bind(&l_nodes);
+
+        std::stringstream l_ss;
+
+        l_ss << disjoin(conjoin(literal(0, true), literal(1, true)), exor(literal(1, true), literal(2, true)));
+
+        l_expected = l_ss.str();
+
+    }
+
+    huge_page_arena l_arena(1 << 20);
+
+    std::pmr::monotonic_buffer_resource l_buffer;
+
+    for (std::pmr::memory_resource* l_resource : { (std::pmr::memory_resource*)&l_arena, (std::pmr::memory_resource*)&l_buffer })
+    {
+        dag l_nodes(l_resource);
+
+        global_node_sink::bind(&l_nodes);
+
+        assert(l_nodes.resource() == l_resource);
+
+        std::stringstream l_ss;
+
+        l_ss << disjoin(conjoin(literal(0, true), literal(1, true)), exor(literal(1, true), literal(2, true)));
+
+        assert(l_ss.str() == l_expected);
+
+        /// The word-level cache shares the resource.
+        operation_cache l_cache(l_nodes.resource());
+
+        bitvector<4> l_sum = sum(l_cache, bitvector<4>::variables(0), bitvector<4>::constant(3));
+
+        for (int i = 0; i < 16; i++)
+        {
+            std::vector<bool> l_input = { (i & 0x1) != 0, (i & 0x2) != 0, (i & 0x4) != 0, (i & 0x8) != 0 };
+
+            int l_value = 0;
+
+            for (size_t j = 0; j < 4; j++)
+                l_value |= evaluate(l_sum[j], l_input) << j;
+
+            assert(l_value == ((i + 3) & 0xf));
+
+        }
+
+    }
+
+    /// The arena maps whole huge pages.
+    assert(l_arena.bytes() >= (2 << 20));
+
+}
+
+void test_frozen(
+
+)
+{
+    std::shared_ptr<const frozen> l_snapshot;
+
+    std::vector<std::string> l_printed;
+    std::vector<std::vector<bool>> l_truth_tables;
+    std::vector<double> l_counts;
+
+    {
+        dag l_nodes;
+
+        global_node_sink::bind(&l_nodes);
+
+        const node* l_a = literal(0, true);
+        const node* l_b = literal(1, true);
+        const node* l_c = literal(2, true);
+
+        std::vector<const node*> l_roots = {
+            disjoin(conjoin(l_a, l_b), exor(l_b, l_c)),
+            conjoin(l_a, invert(l_c)),
+            ZERO,
+            ONE,
+        };
+
+        for (const node* l_root : l_roots)
+        {
+            std::stringstream l_ss;
+
+            l_ss << l_root;
+
+            l_printed.push_back(l_ss.str());
+            l_counts.push_back(count(l_root, 3));
+            l_truth_tables.emplace_back();
+
+            for (int i = 0; i < 8; i++)
+                l_truth_tables.back().push_back(evaluate(l_root, { (i & 0x1) != 0, (i & 0x2) != 0, (i & 0x4) != 0 }));
+
+        }
+
+        l_snapshot = freeze(l_roots);
+
+        assert(l_snapshot->size() == node_count(l_roots[0]) + node_count(l_roots[1]) - 1);
+
+    }
+
+    global_node_sink::bind(nullptr);
+
+    /// The source dag no longer exists.
+    assert(l_snapshot->root_count() == 4);
+
+    for (size_t l_root = 0; l_root < l_snapshot->root_count(); l_root++)
+    {
+        std::stringstream l_ss;
+
+        l_snapshot->print(l_ss, l_root);
+
+        assert(l_ss.str() == l_printed[l_root]);
+        assert(l_snapshot->sat_count(l_root, 3) == l_counts[l_root]);
+
+        for (int i = 0; i < 8; i++)
+            assert(l_snapshot->evaluate(l_root, { (i & 0x1) != 0, (i & 0x2) != 0, (i & 0x4) != 0 }) == l_truth_tables[l_root][i]);
+
+        std::optional<std::vector<bool>> l_assignment = l_snapshot->any_sat(l_root, 3);
+
+        assert(l_assignment.has_value() == (l_counts[l_root] > 0));
+
+        if (l_assignment.has_value())
+            assert(l_snapshot->evaluate(l_root, l_assignment.value()));
+
+    }
+
+    /// A cube deep enough that its fraction underflows
+    ///     to zero, beneath a negated variable.
+    dag l_deep_nodes;
+
+    global_node_sink::bind(&l_deep_nodes);
+
+    const node* l_deep = ONE;
+
+    for (uint32_t i = 1; i <= 1100; i++)
+        l_deep = conjoin(l_deep, literal(i, true));
+
+    l_deep = conjoin(literal(0, false), l_deep);
+
+    std::shared_ptr<const frozen> l_deep_snapshot = freeze({ l_deep });
+
+    std::optional<std::vector<bool>> l_deep_assignment = l_deep_snapshot->any_sat(0, 1101);
+
+    assert(l_deep_assignment.has_value());
+    assert(l_deep_snapshot->evaluate(0, l_deep_assignment.value()));
+
+    global_node_sink::bind(nullptr);
+
+}
+
+void test_trace(
+
+)
+{
+    trace::ring::clear();
+
+    {
+        trace::scope l_outer("outer", 10, 3, 4);
+
+        {
+            trace::scope l_inner("inner", 10, 1);
+            l_inner.finish(12, 2);
+        }
+
+        l_outer.finish(15, 5);
+
+    }
+
+    assert(trace::ring::size() == 2);
+
+    std::stringstream l_ss;
+
+    trace::ring::write(l_ss);
+
+    std::string l_json = l_ss.str();
+
+    /// The inner scope completes, and is recorded, first.
+    assert(l_json.find("\"name\":\"inner\"") < l_json.find("\"name\":\"outer\""));
+    assert(l_json.find("\"x_size\":3,\"y_size\":4,\"result_size\":5,\"dag_delta\":5") != std::string::npos);
+    assert(l_json.find("\"dag_delta\":2") != std::string::npos);
+    assert(l_json.find("\"nodes\":15") != std::string::npos);
+    assert(l_json.front() == '{' && l_json.back() == '}');
+
+    /// A writer flushes the ring when it goes out
+    ///     of scope, as the exit writer of a trace
+    ///     build does.
+    std::string l_path = (std::filesystem::temp_directory_path() / "factor_test_trace.json").string();
+
+    {
+        trace::writer l_writer(l_path);
+    }
+
+    std::ifstream l_ifstream(l_path);
+    std::stringstream l_written;
+
+    l_written << l_ifstream.rdbuf();
+
+    assert(l_written.str() == l_json);
+
+    std::filesystem::remove(l_path);
+
+    trace::ring::clear();
+
+    assert(trace::ring::size() == 0);
+
+}
+
+void test_constraints(
+
+)
+{
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    std::vector<uint32_t> l_variables = { 0, 1, 2, 3, 4 };
+
+    std::map<uint32_t, int64_t> l_weights = { { 0, 3 }, { 1, -2 }, { 2, 5 }, { 4, 1 } };
+
+    for (int64_t k = -1; k <= 6; k++)
+    {
+        const node* l_at_most = at_most(l_variables, k);
+        const node* l_at_least = at_least(l_variables, k);
+        const node* l_exactly = exactly(l_variables, k);
+        const node* l_threshold = threshold(l_weights, k);
+        const node* l_linear = linear(l_weights, k, k + 2);
+
+        for (int i = 0; i < 32; i++)
+        {
+            std::vector<bool> l_input;
+
+            int64_t l_ones = 0;
+            int64_t l_sum = 0;
+
+            for (uint32_t j = 0; j < 5; j++)
+            {
+                l_input.push_back((i >> j) & 0x1);
+                l_ones += l_input.back();
+
+                if (l_weights.contains(j))
+                    l_sum += l_weights[j] * l_input.back();
+
+            }
+
+            assert(evaluate(l_at_most, l_input) == (l_ones <= k));
+            assert(evaluate(l_at_least, l_input) == (l_ones >= k));
+            assert(evaluate(l_exactly, l_input) == (l_ones == k));
+            assert(evaluate(l_threshold, l_input) == (l_sum >= k));
+            assert(evaluate(l_linear, l_input) == (k <= l_sum && l_sum <= k + 2));
+
+        }
+
+    }
+
+    /// The builders emplace no intermediate nodes,
+    ///     and cardinality stays within n (k + 1).
+    dag l_fresh;
+
+    global_node_sink::bind(&l_fresh);
+
+    std::vector<uint32_t> l_many;
+
+    for (uint32_t i = 0; i < 64; i++)
+        l_many.push_back(i);
+
+    const node* l_at_most_three = at_most(l_many, 3);
+
+    assert(l_fresh.size() == node_count(l_at_most_three));
+    assert(l_fresh.size() <= 64 * 4);
+    assert(count(l_at_most_three, 64) == 1 + 64 + 2016 + 41664);
+
+    /// A repeated variable counts twice.
+    assert(exactly({ 5, 5 }, 2) == literal(5, true));
+
+    /// Power-of-two weights make every partial sum
+    ///     distinct, yet the intervals keep a bound on
+    ///     an unsigned word linear in its width.
+    std::map<uint32_t, int64_t> l_word;
+
+    for (uint32_t i = 0; i < 32; i++)
+        l_word[i] = int64_t(1) << i;
+
+    auto l_start = std::chrono::steady_clock::now();
+
+    const node* l_bound = threshold(l_word, 0xB5C3A96D);
+
+    assert(std::chrono::steady_clock::now() - l_start < std::chrono::seconds(1));
+    assert(node_count(l_bound) <= 32);
+
+    std::mt19937_64 l_random(3);
+
+    for (int l_sample = 0; l_sample < 256; l_sample++)
+    {
+        uint64_t l_value = l_random() & 0xFFFFFFFF;
+
+        std::vector<bool> l_input;
+
+        for (uint32_t i = 0; i < 32; i++)
+            l_input.push_back((l_value >> i) & 0x1);
+
+        assert(evaluate(l_bound, l_input) == (l_value >= 0xB5C3A96D));
+
+    }
+
+    /// Two-sided ranges over a shorter word.
+    std::map<uint32_t, int64_t> l_short_word;
+
+    for (uint32_t i = 0; i < 10; i++)
+        l_short_word[i] = int64_t(1) << i;
+
+    const node* l_range = linear(l_short_word, 300, 700);
+
+    for (uint32_t l_value = 0; l_value < 1024; l_value++)
+    {
+        std::vector<bool> l_input;
+
+        for (uint32_t i = 0; i < 10; i++)
+            l_input.push_back((l_value >> i) & 0x1);
+
+        assert(evaluate(l_range, l_input) == (300 <= l_value && l_value <= 700));
+
+    }
+
+}
+
+void test_netlist(
+
+)
+{
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    /// The exclusive or of two inputs, with the
+    ///     gates listed out of dependency order.
+    std::stringstream l_aag(
+        "aag 5 2 0 1 3\n"
+        "2\n"
+        "4\n"
+        "11\n"
+        "10 7 9\n"
+        "6 2 5\n"
+        "8 3 4\n"
+        "i0 a\n"
+        "i1 b\n"
+        "o0 x\n"
+        "c\n"
+        "a comment\n"
+    );
+
+    /// The same circuit in the binary format.
+    std::stringstream l_aig(
+        std::string("aig 5 2 0 1 3\n11\n") +
+        std::string("\x01\x03\x04\x01\x01\x02", 6)
+    );
+
+    for (std::stringstream* l_ss : { &l_aag, &l_aig })
+    {
+        aig::netlist l_netlist = aig::read_aiger(*l_ss);
+
+        assert(l_netlist.m_inputs.size() == 2);
+        assert(l_netlist.m_outputs.size() == 1);
+        assert(l_netlist.m_graph.size() == 6);
+
+        aig::conversion l_conversion = aig::to_dag(l_netlist.m_graph, l_netlist.m_outputs);
+
+        assert(l_conversion.m_variables == std::vector<uint32_t>({ 0, 1 }));
+        assert(l_conversion.m_outputs[0] == exor(literal(0, true), literal(1, true)));
+
+    }
+
+    /// Symbols name the inputs and outputs, which
+    ///     otherwise take their default names.
+    std::stringstream l_buffer("aag 1 1 0 2 0\n2\n2\n3\ni0 a\no1 y\n");
+
+    aig::netlist l_named = aig::read_aiger(l_buffer);
+
+    assert(l_named.m_input_names == std::vector<std::string>({ "a" }));
+    assert(l_named.m_output_names == std::vector<std::string>({ "o0", "y" }));
+    assert(l_named.m_outputs[1] == aig::invert(l_named.m_outputs[0]));
+
+    std::stringstream l_blif(
+        "# a full adder\n"
+        ".model full_adder\n"
+        ".inputs a b \\\n"
+        "    cin\n"
+        ".outputs s cout\n"
+        ".names a b cin s\n"
+        "100 1\n"
+        "010 1\n"
+        "001 1\n"
+        "111 1\n"
+        ".names t cout\n"
+        "0 0\n"
+        ".names a b cin t\n"
+        "11- 1\n"
+        "1-1 1\n"
+        "-11 1\n"
+        ".end\n"
+    );
+
+    aig::netlist l_netlist = aig::read_blif(l_blif);
+
+    assert(l_netlist.m_input_names == std::vector<std::string>({ "a", "b", "cin" }));
+    assert(l_netlist.m_output_names == std::vector<std::string>({ "s", "cout" }));
+
+    aig::conversion l_conversion = aig::to_dag(l_netlist.m_graph, l_netlist.m_outputs);
+
+    for (int i = 0; i < 8; i++)
+    {
+        std::vector<bool> l_input(3);
+
+        for (size_t j = 0; j < 3; j++)
+            l_input[l_conversion.m_variables[j]] = (i >> j) & 0x1;
+
+        int l_sum = (i & 0x1) + ((i >> 1) & 0x1) + ((i >> 2) & 0x1);
+
+        assert(evaluate(l_conversion.m_outputs[0], l_input) == (l_sum & 0x1));
+        assert(evaluate(l_conversion.m_outputs[1], l_input) == (l_sum >= 2));
+
+    }
+
+    /// Malformed and sequential circuits are rejected.
+    for (std::string l_text : {
+        "aag 1 0 1 0 0\n2 3\n",
+        "aag 2 1 0 1 1\n2\n4\n4 4 2\n",
+        "bogus",
+        /// Fewer variables than inputs and gates.
+        "aig 1 2 0 0 0\n",
+        "aig 1 1 0 1 1\n2\n\x02\x02",
+        "aag 1 1 0 1 1\n2\n2\n2 2 2\n",
+        /// Binary variables which are not consecutive.
+        "aig 3 1 0 1 1\n4\n\x02\x02",
+        /// Inputs on the constant or defined twice.
+        "aag 1 1 0 0 0\n0\n",
+        "aag 2 2 0 0 0\n2\n2\n",
+        /// A gate redefining an input.
+        "aag 2 1 0 1 1\n2\n2\n2 4 4\n",
+        /// A binary delta reaching below literal zero.
+        "aig 2 1 0 1 1\n4\n\x05\x00",
+    })
+    {
+        std::stringstream l_ss(l_text);
+
+        bool l_thrown = false;
+
+        try
+        {
+            aig::read_aiger(l_ss);
+        }
+        catch (const std::runtime_error&)
+        {
+            l_thrown = true;
+        }
+
+        assert(l_thrown);
+
+    }
+
+}
+
+void test_aig_lazy(
+
+)
+{
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    aig::graph l_graph;
+
+    aig::global_graph_sink::bind(&l_graph);
+
+    /// Constants and repeated fanins fold away
+    ///     without adding any gate.
+    aig::edge l_a = l_graph.input();
+
+    size_t l_size = l_graph.size();
+
+    assert(l_graph.conjoin(l_a, aig::ZERO_EDGE) == aig::ZERO_EDGE);
+    assert(l_graph.conjoin(aig::ONE_EDGE, l_a) == l_a);
+    assert(l_graph.conjoin(l_a, l_a) == l_a);
+    assert(l_graph.conjoin(l_a, aig::invert(l_a)) == aig::ZERO_EDGE);
+    assert(l_graph.disjoin(l_a, aig::invert(l_a)) == aig::ONE_EDGE);
+    assert(l_graph.size() == l_size);
+
+    /// Build a 4x4 product through the logic templates,
+    ///     with x on variables 0..3 and y on 4..7, after
+    ///     the first input a.
+    std::list<aig::signal> l_x;
+    std::list<aig::signal> l_y;
+
+    for (int i = 0; i < 8; i++)
+        (i < 4 ? l_x : l_y).push_back({ l_graph.input() });
+
+    std::list<aig::signal> l_product = multiply(l_x, l_y);
+    std::list<aig::signal> l_commuted = multiply(l_y, l_x);
+
+    /// Multiplying by zero builds nothing.
+    l_size = l_graph.size();
+
+    std::list<aig::signal> l_zeros(4, logic::padding<aig::signal>(false));
+
+    for (const aig::signal& l_bit : multiply(l_x, l_zeros))
+        assert(l_bit.m_edge == aig::ZERO_EDGE);
+
+    assert(l_graph.size() == l_size);
+
+    /// Simulation agrees with the product everywhere.
+    for (uint32_t l_input = 0; l_input < 256; l_input++)
+    {
+        std::vector<bool> l_values = { false };
+
+        for (int i = 0; i < 8; i++)
+            l_values.push_back((l_input >> i) & 0x1);
+
+        uint32_t l_expected = (l_input & 0xF) * (l_input >> 4);
+        uint32_t l_bit = 0;
+
+        for (const aig::signal& l_signal : l_product)
+            assert(aig::evaluate(l_graph, l_signal.m_edge, l_values) == ((l_expected >> l_bit++) & 0x1));
+
+    }
+
+    /// Input a holds variable 8, so that the product
+    ///     lands on the same variables as below.
+    aig::materializer l_materializer(l_graph, { 8, 0, 1, 2, 3, 4, 5, 6, 7 });
+
+    /// The least significant bit is a single gate, so
+    ///     materializing it converts next to nothing.
+    l_materializer.materialize(l_product.front().m_edge);
+
+    assert(l_materializer.size() == l_graph.inputs().size() + 2);
+
+    /// Each materialized bit is the canonical DAG that
+    ///     eager multiplication would have joined.
+    std::list<const node*> l_eager_x;
+    std::list<const node*> l_eager_y;
+
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        l_eager_x.push_back(literal(i, true));
+        l_eager_y.push_back(literal(i + 4, true));
+    }
+
+    std::list<const node*> l_eager = multiply(l_eager_x, l_eager_y);
+
+    auto l_eager_it = l_eager.begin();
+    auto l_commuted_it = l_commuted.begin();
+
+    for (const aig::signal& l_signal : l_product)
+    {
+        assert(l_materializer.materialize(l_signal.m_edge) == *l_eager_it++);
+        assert(l_materializer.equivalent(l_signal.m_edge, (l_commuted_it++)->m_edge));
+    }
+
+    assert(!l_materializer.equivalent(l_product.front().m_edge, l_product.back().m_edge));
+
+    /// Eager conversion may collect the dropped gates,
+    ///     sparing the nodes the caller retains.
+    std::vector<aig::edge> l_edges;
+
+    for (const aig::signal& l_signal : l_product)
+        l_edges.push_back(l_signal.m_edge);
+
+    dag l_plain_nodes;
+
+    global_node_sink::bind(&l_plain_nodes);
+
+    aig::conversion l_plain = aig::to_dag(l_graph, l_edges);
+
+    dag l_collected_nodes;
+
+    global_node_sink::bind(&l_collected_nodes);
+
+    const node* l_kept = conjoin(literal(20, true), literal(21, true));
+
+    aig::conversion l_collected = aig::to_dag(l_graph, l_edges, std::vector<const node*>({ l_kept }));
+
+    assert(l_collected.m_variables == l_plain.m_variables);
+    assert(l_collected_nodes.size() < l_plain_nodes.size());
+
+    for (uint32_t l_input = 0; l_input < 512; l_input++)
+    {
+        std::vector<bool> l_values(22, false);
+
+        for (int i = 0; i < 9; i++)
+            l_values[i] = (l_input >> i) & 0x1;
+
+        l_values[20] = l_values[21] = l_input & 0x1;
+
+        for (size_t i = 0; i < l_edges.size(); i++)
+        {
+            global_node_sink::bind(&l_plain_nodes);
+            bool l_expected = evaluate(l_plain.m_outputs[i], l_values);
+
+            global_node_sink::bind(&l_collected_nodes);
+            assert(evaluate(l_collected.m_outputs[i], l_values) == l_expected);
+        }
+
+        assert(evaluate(l_kept, l_values) == (l_input & 0x1));
+
+    }
+
+    global_node_sink::bind(&l_nodes);
+
+    aig::global_graph_sink::bind(nullptr);
+
+}
+
+void test_equivalence(
+
+)
+{
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    aig::graph l_graph;
+
+    aig::global_graph_sink::bind(&l_graph);
+
+    std::list<aig::signal> l_x;
+    std::list<aig::signal> l_y;
+
+    for (int i = 0; i < 10; i++)
+        (i < 5 ? l_x : l_y).push_back({ l_graph.input() });
+
+    std::vector<aig::signal> l_product;
+    std::vector<aig::signal> l_commuted;
+
+    for (const aig::signal& l_bit : multiply(l_x, l_y))
+        l_product.push_back(l_bit);
+
+    for (const aig::signal& l_bit : multiply(l_y, l_x))
+        l_commuted.push_back(l_bit);
+
+    /// Differs from the middle product bit only when
+    ///     every input is set.
+    aig::signal l_all = logic::padding<aig::signal>(true);
+
+    for (const aig::signal& l_bit : l_x)
+        l_all = logic::conjoin(l_all, l_bit);
+
+    for (const aig::signal& l_bit : l_y)
+        l_all = logic::conjoin(l_all, l_bit);
+
+    aig::signal l_faulty = logic::exor(l_product[5], l_all);
+
+    aig::materializer l_materializer(l_graph);
+
+    /// A tight budget leaves the middle bits undecided,
+    ///     and the dag's own limits are restored.
+    budget l_budget;
+    l_budget.m_node_limit = l_nodes.size() + 4;
+
+    aig::equivalence l_unknown =
+        aig::check_equivalence(l_materializer, l_product[5].m_edge, l_commuted[5].m_edge, 16, l_budget);
+
+    assert(l_unknown.m_verdict == aig::equivalence::verdict::UNKNOWN);
+    assert(l_nodes.limits().m_node_limit == SIZE_MAX);
+
+    /// The default budget keeps the dag's own limits,
+    ///     and the pressure callback, once fired, is
+    ///     not rearmed by the check.
+    size_t l_pressures = 0;
+
+    budget l_own;
+    l_own.m_node_limit = l_nodes.size() + 4;
+    l_own.m_pressure_node_count = l_nodes.size() + 1;
+    l_own.m_pressure = [&l_pressures](dag&) { l_pressures++; };
+
+    l_nodes.limit(l_own);
+
+    for (int i = 0; i < 2; i++)
+        assert(
+            aig::check_equivalence(l_materializer, l_product[6].m_edge, l_commuted[6].m_edge).m_verdict ==
+            aig::equivalence::verdict::UNKNOWN
+        );
+
+    assert(l_pressures == 1);
+    assert(l_nodes.limits().m_node_limit == l_own.m_node_limit);
+
+    l_nodes.limit(budget());
+
+    for (size_t i = 0; i < l_product.size(); i++)
+        assert(
+            aig::check_equivalence(l_materializer, l_product[i].m_edge, l_commuted[i].m_edge).m_verdict ==
+            aig::equivalence::verdict::EQUIVALENT
+        );
+
+    /// Simulation separates distinct product bits,
+    ///     without converting anything further.
+    size_t l_materialized = l_materializer.size();
+
+    aig::equivalence l_simulated =
+        aig::check_equivalence(l_materializer, l_product[3].m_edge, l_product[4].m_edge, 1);
+
+    assert(l_simulated.m_verdict == aig::equivalence::verdict::DIFFERENT);
+    assert(l_materializer.size() == l_materialized);
+    assert(
+        aig::evaluate(l_graph, l_product[3].m_edge, l_simulated.m_counterexample) !=
+        aig::evaluate(l_graph, l_product[4].m_edge, l_simulated.m_counterexample)
+    );
+
+    /// Without simulation, the counterexample to the
+    ///     single differing pattern is read off the DAGs.
+    aig::equivalence l_proven =
+        aig::check_equivalence(l_materializer, l_product[5].m_edge, l_faulty.m_edge, 0);
+
+    assert(l_proven.m_verdict == aig::equivalence::verdict::DIFFERENT);
+    assert(l_proven.m_counterexample == std::vector<bool>(10, true));
+
+    aig::global_graph_sink::bind(nullptr);
+
+}
+
+void test_repl(
+
+)
+{
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    repl l_repl;
+
+    std::stringstream l_input(
+        "define a 0\n"
+        "define b 1\n"
+        "define c 2'\n"
+        "conjoin ab a b\n"
+        "disjoin f ab c\n"
+        "print ab\n"
+        "evaluate f 110\n"
+        "evaluate f 011\n"
+        "count f 3\n"
+        "any_sat ab\n"
+        "invert g f\n"
+        "exor z f f\n"
+        "any_sat z\n"
+        "parse p [0][1]\n"
+        "exnor same p ab\n"
+        "print same\n"
+        "\n"
+        "print missing\n"
+        "frobnicate\n"
+        "parse bad [1\n"
+        "parse bad [1]]\n"
+        "parse bad ([1]\n"
+        "parse bad '[1]\n"
+        "count f 4294967295\n"
+        "count f 2\n"
+        "define big 4294967295\n"
+        "drop g\n"
+        "stats\n"
+        "quit\n"
+        "print f\n"
+    );
+
+    std::stringstream l_output;
+
+    l_repl.run(l_input, l_output);
+
+    std::vector<std::string> l_lines;
+
+    for (std::string l_line; std::getline(l_output, l_line);)
+        l_lines.push_back(l_line);
+
+    assert(l_lines.size() == 28);
+    assert(l_lines[5] == "ok [0][1]");
+    assert(l_lines[6] == "ok 1");
+    assert(l_lines[7] == "ok 0");
+    assert(l_lines[8] == "ok 5");
+    assert(l_lines[9] == "ok 11");
+    assert(l_lines[12] == "ok none");
+    assert(l_lines[15] == "ok 1");
+    assert(l_lines[16] == "error undefined name missing");
+    assert(l_lines[17] == "error unknown command frobnicate");
+
+    for (size_t i = 18; i < 22; i++)
+        assert(l_lines[i] == "error malformed expression");
+
+    assert(l_lines[22] == "error variable count out of range");
+    assert(l_lines[23] == "error variable count out of range");
+    assert(l_lines[24] == "error variable out of range");
+    assert(l_lines[26].starts_with("ok nodes "));
+    assert(l_lines[26].find(" names 8 ") != std::string::npos);
+    assert(l_lines[27] == "ok");
+
+    /// The repl binds its own dag only while executing.
+    assert(global_node_sink::bound() == &l_nodes);
+    assert(l_nodes.size() == 0);
+
+}
+
+void test_checkpoint(
+
+)
+{
+    std::filesystem::path l_path = std::filesystem::temp_directory_path() / "factor_test_checkpoint.fctc";
+
+    std::filesystem::remove(l_path);
+
+    std::vector<uint32_t> l_variables = { 0, 1, 2, 3, 4, 5, 6, 7 };
+
+    const auto l_text = [](const node* a_node)
+    {
+        std::stringstream l_ss;
+        l_ss << a_node;
+        return l_ss.str();
+    };
+
+    std::map<std::string, std::string> l_expected;
+
+    uint64_t l_node_count;
+
+    {
+        dag l_nodes;
+
+        global_node_sink::bind(&l_nodes);
+
+        checkpoint l_checkpoint(l_path.string());
+
+        assert(l_checkpoint.commits() == 0);
+
+        for (int i = 0; i < 4; i++)
+        {
+            std::string l_name = "exactly " + std::to_string(i);
+
+            const node* l_constraint = exactly(l_variables, i);
+
+            l_checkpoint.save({ { l_name, l_constraint } });
+
+            l_expected[l_name] = l_text(l_constraint);
+
+        }
+
+        /// Saving again writes nothing but the commit.
+        uintmax_t l_size = std::filesystem::file_size(l_path);
+
+        l_checkpoint.save(l_checkpoint.roots());
+
+        assert(std::filesystem::file_size(l_path) == l_size + 1 + 8);
+        assert(l_checkpoint.commits() == 5);
+
+        l_node_count = l_checkpoint.node_count();
+
+        assert(l_node_count <= l_nodes.size());
+
+    }
+
+    /// Crash partway through writing a node.
+    {
+        std::ofstream l_ofstream(l_path, std::ios::binary | std::ios::app);
+        l_ofstream.write("N\x01\x00", 3);
+    }
+
+    {
+        dag l_nodes;
+
+        global_node_sink::bind(&l_nodes);
+
+        checkpoint l_checkpoint(l_path.string());
+
+        assert(l_checkpoint.commits() == 5);
+        assert(l_checkpoint.node_count() == l_node_count);
+        assert(l_nodes.size() == l_node_count);
+        assert(l_checkpoint.roots().size() == 4);
+
+        for (const auto& [l_name, l_root] : l_checkpoint.roots())
+            assert(l_text(l_root) == l_expected.at(l_name));
+
+        /// Resume the build, sharing the resumed nodes.
+        const node* l_constraint = exactly(l_variables, 4);
+
+        l_checkpoint.save({ { "exactly 4", l_constraint } });
+
+        l_expected["exactly 4"] = l_text(l_constraint);
+
+    }
+
+    {
+        dag l_nodes;
+
+        global_node_sink::bind(&l_nodes);
+
+        checkpoint l_checkpoint(l_path.string());
+
+        assert(l_checkpoint.commits() == 6);
+        assert(l_checkpoint.roots().size() == 5);
+
+        for (const auto& [l_name, l_root] : l_checkpoint.roots())
+            assert(l_text(l_root) == l_expected.at(l_name));
+
+        /// A collection frees addresses for reuse, so
+        ///     the next save writes its nodes anew.
+        uint64_t l_generation = l_nodes.generation();
+
+        at_least(l_variables, 2);
+
+        std::vector<const node*> l_kept;
+
+        for (const auto& [l_name, l_root] : l_checkpoint.roots())
+            l_kept.push_back(l_root);
+
+        assert(l_nodes.collect(l_kept) > 0);
+        assert(l_nodes.generation() != l_generation);
+
+        const node* l_constraint = at_most(l_variables, 2);
+
+        uint64_t l_written = l_checkpoint.node_count();
+
+        l_checkpoint.save({ { "at most 2", l_constraint } });
+
+        assert(l_checkpoint.node_count() - l_written == node_count(l_constraint));
+
+        l_expected["at most 2"] = l_text(l_constraint);
+
+    }
+
+    {
+        dag l_nodes;
+
+        global_node_sink::bind(&l_nodes);
+
+        checkpoint l_checkpoint(l_path.string());
+
+        assert(l_checkpoint.commits() == 7);
+        assert(l_checkpoint.roots().size() == 6);
+
+        for (const auto& [l_name, l_root] : l_checkpoint.roots())
+            assert(l_text(l_root) == l_expected.at(l_name));
+
+    }
+
+    std::filesystem::remove(l_path);
+
+    global_node_sink::bind(nullptr);
+
+}
+
+void test_codegen(
+
+)
+{
+    dag l_nodes;
+
+    global_node_sink::bind(&l_nodes);
+
+    std::list<const node*> l_x;
+    std::list<const node*> l_y;
+
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        l_x.push_back(literal(i, true));
+        l_y.push_back(literal(i + 4, true));
+    }
+
+    std::vector<const node*> l_roots;
+
+    for (const node* l_bit : multiply(l_x, l_y))
+        l_roots.push_back(l_bit);
+
+    l_roots.push_back(ZERO);
+    l_roots.push_back(ONE);
+    l_roots.push_back(exactly({ 0, 2, 5, 7 }, 2));
+
+    std::filesystem::path l_directory = std::filesystem::temp_directory_path();
+    std::filesystem::path l_source = l_directory / "factor_test_codegen.cpp";
+    std::filesystem::path l_binary = l_directory / "factor_test_codegen";
+
+    {
+        std::ofstream l_ofstream(l_source);
+
+        l_ofstream << "#include <stdint.h>\n#include <stdio.h>\n";
+
+        emit_branches(l_ofstream, "branches", l_roots);
+        emit_mux(l_ofstream, "mux", l_roots);
+        emit_lanes(l_ofstream, "lanes", l_roots);
+
+        /// Print every input's results from all three.
+        l_ofstream <<
+            "int main()\n"
+            "{\n"
+            "    for (uint64_t b = 0; b < 4; b++)\n"
+            "    {\n"
+            "        uint64_t x[8] = {};\n"
+            "        uint64_t r[11];\n"
+            "        for (uint64_t l = 0; l < 64; l++)\n"
+            "            for (int v = 0; v < 8; v++)\n"
+            "                x[v] |= (((b * 64 + l) >> v) & 1) << l;\n"
+            "        lanes(x, r);\n"
+            "        for (uint64_t l = 0; l < 64; l++)\n"
+            "        {\n"
+            "            uint64_t s = 0;\n"
+            "            for (int i = 0; i < 11; i++)\n"
+            "                s |= ((r[i] >> l) & 1) << i;\n"
+            "            printf(\"%llu %llu %llu\\n\", (unsigned long long)branches(b * 64 + l),\n"
+            "                (unsigned long long)mux(b * 64 + l), (unsigned long long)s);\n"
+            "        }\n"
+            "    }\n"
+            "}\n";
+
+    }
+
+    std::string l_compile = "g++ -O1 -o \"" + l_binary.string() + "\" \"" + l_source.string() + "\"";
+
+    assert(std::system(l_compile.c_str()) == 0);
+
+    FILE* l_pipe = popen(("\"" + l_binary.string() + "\"").c_str(), "r");
+
+    assert(l_pipe != nullptr);
+
+    for (uint64_t l_input = 0; l_input < 256; l_input++)
+    {
+        unsigned long long l_branches;
+        unsigned long long l_mux;
+        unsigned long long l_lanes;
+
+        assert(fscanf(l_pipe, "%llu %llu %llu", &l_branches, &l_mux, &l_lanes) == 3);
+
+        std::vector<bool> l_values;
+
+        for (int v = 0; v < 8; v++)
+            l_values.push_back((l_input >> v) & 0x1);
+
+        uint64_t l_expected = 0;
+
+        for (size_t i = 0; i < l_roots.size(); i++)
+            l_expected |= uint64_t(evaluate(l_roots[i], l_values)) << i;
+
+        assert(l_branches == l_expected);
+        assert(l_mux == l_expected);
+        assert(l_lanes == l_expected);
+
+    }
+
+    assert(pclose(l_pipe) == 0);
+
+    std::filesystem::remove(l_source);
+    std::filesystem::remove(l_binary);
+
+    global_node_sink::bind(nullptr);
+
+}
+
+void test_truth_table_leaves(
+
+)
+{
+    /// Build the same functions without and with
+    ///     leaves over the last six of eight depths.
+    dag l_plain_nodes;
+    dag l_leaf_nodes;
+
+    l_leaf_nodes.leaves(2, 6);
+
+    std::vector<std::vector<const node*>> l_functions(2);
+
+    for (int l_variant = 0; l_variant < 2; l_variant++)
+    {
+        global_node_sink::bind(l_variant == 0 ? &l_plain_nodes : &l_leaf_nodes);
+
+        std::list<const node*> l_x;
+        std::list<const node*> l_y;
+
+        for (uint32_t i = 0; i < 4; i++)
+        {
+            l_x.push_back(literal(i, true));
+            l_y.push_back(literal(i + 4, i % 2 == 0));
+        }
+
+        std::vector<const node*>& l_results = l_functions[l_variant];
+
+        for (const node* l_bit : multiply(l_x, l_y))
+            l_results.push_back(l_bit);
+
+        std::map<std::tuple<operation, const node*, const node*>, const node*> l_cache;
+
+        l_results.push_back(apply(l_cache, operation::XOR, l_results[2], l_results[5]));
+        l_results.push_back(apply(l_cache, operation::IMPLICATION, l_results[3], l_results[1]));
+        l_results.push_back(invert(l_results[4]));
+        l_results.push_back(exnor(l_y.back(), l_x.back()));
+        l_results.push_back(conjoin(l_y.front(), invert(l_y.back())));
+
+    }
+
+    for (size_t i = 0; i < l_functions[0].size(); i++)
+    {
+        const node* l_plain = l_functions[0][i];
+        const node* l_leaf = l_functions[1][i];
+
+        std::stringstream l_plain_text;
+        std::stringstream l_leaf_text;
+
+        l_plain_text << l_plain;
+        l_leaf_text << l_leaf;
+
+        assert(l_plain_text.str() == l_leaf_text.str());
+        assert(count(l_plain, 8) == count(l_leaf, 8));
+        assert(node_count(l_leaf) <= node_count(l_plain));
+
+        for (uint32_t l_input = 0; l_input < 256; l_input++)
+        {
+            std::vector<bool> l_values;
+
+            for (int v = 0; v < 8; v++)
+                l_values.push_back((l_input >> v) & 0x1);
+
+            assert(evaluate(l_plain, l_values) == evaluate(l_leaf, l_values));
+
+        }
+
+    }
+
+    /// The leaf region absorbs everything beneath
+    ///     the first two depths.
+    size_t l_plain_count = 0;
+    size_t l_leaf_count = 0;
+
+    for (size_t i = 0; i < l_functions[0].size(); i++)
+    {
+        l_plain_count += node_count(l_functions[0][i]);
+        l_leaf_count += node_count(l_functions[1][i]);
+    }
+
+    assert(l_leaf_count < l_plain_count / 4);
+    assert(l_leaf_nodes.size() < l_plain_nodes.size());
+
+    for (const node* l_leaf : l_functions[1])
+        for (const node* l_node = l_leaf; l_node != ZERO && l_node != ONE && !l_node->is_leaf(); l_node = l_node->negative())
+            assert(l_node->depth() < 2);
+
+    /// The predicates and support read leaves by
+    ///     their tables, and so agree across the dags.
+    std::vector<std::vector<size_t>> l_predicates(2);
+
+    for (int l_variant = 0; l_variant < 2; l_variant++)
+    {
+        global_node_sink::bind(l_variant == 0 ? &l_plain_nodes : &l_leaf_nodes);
+
+        const std::vector<const node*>& l_nodes = l_functions[l_variant];
+
+        std::set<std::pair<const node*, const node*>> l_disjoint;
+        std::set<std::pair<const node*, const node*>> l_implied;
+        std::set<std::tuple<const node*, const node*, const node*>> l_agreed;
+
+        for (const node* l_x : l_nodes)
+        {
+            l_predicates[l_variant].push_back(support(l_x).size());
+
+            for (const node* l_y : l_nodes)
+            {
+                l_predicates[l_variant].push_back(is_disjoint(l_disjoint, l_x, l_y));
+                l_predicates[l_variant].push_back(implies(l_implied, l_x, l_y));
+
+                for (const node* l_constraint : { l_nodes[8], l_nodes[12], l_nodes[1] })
+                    l_predicates[l_variant].push_back(equal_under(l_agreed, l_x, l_y, l_constraint));
+
+            }
+
+        }
+
+    }
+
+    assert(l_predicates[0] == l_predicates[1]);
+
+    global_node_sink::bind(&l_leaf_nodes);
+
+    /// The traversals which read stored children throw.
+    bool l_thrown = false;
+
+    std::map<std::pair<const node*, const node*>, const node*> l_constrained;
+
+    try { constrain(l_constrained, l_functions[1][3], l_functions[1][12]); } catch (const std::logic_error&) { l_thrown = true; }
+
+    assert(l_thrown);
+
+    l_thrown = false;
+
+    try { freeze({ l_functions[1][3] }); } catch (const std::logic_error&) { l_thrown = true; }
+
+    assert(l_thrown);
+
+    /// Collection must not follow a leaf's table.
+    l_leaf_nodes.collect({ l_functions[1][3] });
+
+    assert(l_leaf_nodes.size() == node_count(l_functions[1][3]));
+
+    l_thrown = false;
+
+    try { l_leaf_nodes.leaves(0, 4); } catch (const std::runtime_error&) { l_thrown = true; }
+
+    assert(l_thrown);
+
+    l_thrown = false;
+
+    try { dag().leaves(0, 7); } catch (const std::runtime_error&) { l_thrown = true; }
+
+    assert(l_thrown);
+
+    global_node_sink::bind(nullptr);
+
+}
+
+void test_chain_nodes(
+
+)
+{
+    /// Build the same functions without and with
+    ///     chain nodes.
+    dag l_plain_nodes;
+    dag l_chained_nodes;
+
+    l_chained_nodes.chains(true);
+
+    std::vector<std::vector<const node*>> l_functions(2);
+
+    /// The number of functions before the product,
+    ///     which has few runs to chain.
+    size_t l_cube_heavy = 0;
+
+    for (int l_variant = 0; l_variant < 2; l_variant++)
+    {
+        global_node_sink::bind(l_variant == 0 ? &l_plain_nodes : &l_chained_nodes);
+
+        std::vector<const node*>& l_results = l_functions[l_variant];
+
+        /// A cube longer than any one chain.
+        const node* l_long_cube = ONE;
+
+        for (uint32_t i = 0; i < 30; i++)
+            l_long_cube = conjoin(l_long_cube, literal(i, i % 3 != 0));
+
+        l_results.push_back(l_long_cube);
+
+        /// A sum of overlapping cubes.
+        const node* l_sum = ZERO;
+
+        for (uint32_t j = 0; j < 6; j++)
+        {
+            const node* l_cube = ONE;
+
+            for (uint32_t i = 0; i < 8; i++)
+                l_cube = conjoin(l_cube, literal(3 * j + i, (i + j) % 2 == 0));
+
+            l_results.push_back(l_cube);
+
+            l_sum = disjoin(l_sum, l_cube);
+
+        }
+
+        l_results.push_back(l_sum);
+        l_results.push_back(invert(l_sum));
+        l_results.push_back(invert(l_long_cube));
+
+        std::map<std::tuple<operation, const node*, const node*>, const node*> l_cache;
+
+        l_results.push_back(apply(l_cache, operation::XOR, l_results[1], l_results[2]));
+        l_results.push_back(apply(l_cache, operation::IMPLICATION, l_results[3], l_long_cube));
+
+        /// The equality of two words, and a product.
+        std::list<const node*> l_x;
+        std::list<const node*> l_y;
+
+        for (uint32_t i = 0; i < 6; i++)
+        {
+            l_x.push_back(literal(i, true));
+            l_y.push_back(literal(i + 6, true));
+        }
+
+        l_results.push_back(exnor(l_x, l_y));
+
+        l_cube_heavy = l_results.size();
+
+        for (const node* l_bit : multiply(l_x, l_y))
+            l_results.push_back(l_bit);
+
+    }
+
+    size_t l_plain_count = 0;
+    size_t l_chained_count = 0;
+
+    std::mt19937 l_random(7);
+
+    for (size_t i = 0; i < l_functions[0].size(); i++)
+    {
+        const node* l_plain = l_functions[0][i];
+        const node* l_chained = l_functions[1][i];
+
+        std::stringstream l_plain_text;
+        std::stringstream l_chained_text;
+
+        l_plain_text << l_plain;
+        l_chained_text << l_chained;
+
+        assert(l_plain_text.str() == l_chained_text.str());
+        assert(count(l_plain, 32) == count(l_chained, 32));
+
+        for (int l_sample = 0; l_sample < 256; l_sample++)
+        {
+            std::vector<bool> l_values;
+
+            for (int v = 0; v < 32; v++)
+                l_values.push_back(l_random() & 0x1);
+
+            assert(evaluate(l_plain, l_values) == evaluate(l_chained, l_values));
+
+        }
+
+        if (i < l_cube_heavy)
+        {
+            l_plain_count += node_count(l_plain);
+            l_chained_count += node_count(l_chained);
+        }
+
+    }
+
+    /// The long cube needs two chains, as no chain
+    ///     runs longer than MAX_CHAIN_LENGTH depths.
+    assert(node_count(l_functions[1][0]) == 2);
+    assert(node_count(l_functions[1][1]) == 1);
+    assert(l_chained_count < l_plain_count * 3 / 5);
+
+    bool l_thrown = false;
+
+    try { l_chained_nodes.chains(false); } catch (const std::runtime_error&) { l_thrown = true; }
+
+    assert(l_thrown);
+
+    /// Joining above a chain takes none of its
+    ///     cofactors, so only the result is emplaced,
+    ///     even once the continuations are collected.
+    dag l_joined_nodes;
+
+    l_joined_nodes.chains(true);
+
+    global_node_sink::bind(&l_joined_nodes);
+
+    const node* l_chain = ONE;
+
+    for (uint32_t i = 10; i < 20; i++)
+        l_chain = conjoin(l_chain, literal(i, true));
+
+    const node* l_above = literal(0, true);
+
+    l_joined_nodes.collect({ l_chain, l_above });
+
+    size_t l_joined_size = l_joined_nodes.size();
+
+    const node* l_joined = conjoin(l_above, l_chain);
+
+    assert(l_joined_nodes.size() == l_joined_size + 1);
+    assert(l_joined->negative() == ZERO && l_joined->positive() == l_chain);
+
+    /// The traversals take the logical cofactors of
+    ///     chain nodes, and so agree across the dags.
+    std::vector<std::vector<std::string>> l_traversals(2);
+
+    for (int l_variant = 0; l_variant < 2; l_variant++)
+    {
+        dag& l_nodes = l_variant == 0 ? l_plain_nodes : l_chained_nodes;
+
+        global_node_sink::bind(&l_nodes);
+
+        std::vector<std::string>& l_results = l_traversals[l_variant];
+
+        const auto l_record = [&l_results](const node* a_node)
+        {
+            std::stringstream l_ss;
+            l_ss << a_node;
+            l_results.push_back(l_ss.str());
+        };
+
+        const node* l_cube = ONE;
+
+        for (uint32_t i = 0; i < 5; i++)
+            l_cube = conjoin(l_cube, literal(i, true));
+
+        const node* l_care = literal(2, true);
+        const node* l_sum = l_functions[l_variant][7];
+
+        std::map<std::pair<const node*, const node*>, const node*> l_constrained;
+        std::map<std::pair<const node*, const node*>, const node*> l_restricted;
+        std::map<std::tuple<operation, const node*, const node*>, const node*> l_applications;
+
+        l_record(constrain(l_constrained, l_cube, l_care));
+        l_record(constrain(l_constrained, l_sum, l_cube));
+        l_record(restrict(l_restricted, l_applications, l_cube, l_care));
+        l_record(restrict(l_restricted, l_applications, l_sum, invert(l_cube)));
+
+        std::set<std::pair<const node*, const node*>> l_implied;
+        std::set<std::pair<const node*, const node*>> l_disjoint;
+        std::set<std::tuple<const node*, const node*, const node*>> l_agreed;
+
+        l_results.push_back(std::to_string(implies(l_implied, l_cube, l_care)));
+        l_results.push_back(std::to_string(implies(l_implied, l_functions[l_variant][1], l_sum)));
+        l_results.push_back(std::to_string(implies(l_implied, l_sum, l_functions[l_variant][1])));
+        l_results.push_back(std::to_string(is_disjoint(l_disjoint, l_cube, invert(l_care))));
+        l_results.push_back(std::to_string(is_disjoint(l_disjoint, l_sum, l_functions[l_variant][0])));
+        l_results.push_back(std::to_string(equal_under(l_agreed, l_cube, l_care, l_cube)));
+        l_results.push_back(std::to_string(equal_under(l_agreed, l_cube, l_sum, l_care)));
+
+        for (uint32_t l_variable : support(l_sum))
+            l_results.push_back(std::to_string(l_variable));
+
+        std::map<const node*, const node*> l_shifted;
+        std::map<const node*, const node*> l_permuted;
+
+        l_record(shift(l_shifted, l_sum, 3));
+        l_record(permute(l_permuted, l_applications, { { 0, 9 }, { 9, 0 } }, l_sum));
+        l_record(join_breadth_first(ONE, ZERO, l_sum, invert(l_cube)));
+
+        dag l_destination;
+
+        std::vector<const node*> l_compacted = compact(l_destination, { l_sum, l_cube }, layout::LEVEL);
+
+        global_node_sink::bind(&l_destination);
+
+        l_record(l_compacted[0]);
+        l_record(l_compacted[1]);
+
+    }
+
+    assert(l_traversals[0] == l_traversals[1]);
+
+    /// A checkpoint keeps the chains of its nodes.
+    std::filesystem::path l_path = std::filesystem::temp_directory_path() / "factor_test_chain_nodes.fctc";
+
+    std::filesystem::remove(l_path);
+
+    global_node_sink::bind(&l_chained_nodes);
+
+    {
+        checkpoint l_checkpoint(l_path.string());
+
+        l_checkpoint.save({ { "sum", l_functions[1][7] }, { "cube", l_functions[1][0] } });
+    }
+
+    for (dag* l_nodes : { &l_plain_nodes, &l_chained_nodes })
+    {
+        dag l_resumed_nodes;
+
+        l_resumed_nodes.chains(l_nodes->chained());
+
+        global_node_sink::bind(&l_resumed_nodes);
+
+        checkpoint l_checkpoint(l_path.string());
+
+        std::stringstream l_expected;
+        std::stringstream l_resumed;
+
+        l_expected << l_functions[0][7] << l_functions[0][0];
+        l_resumed << l_checkpoint.roots().at("sum") << l_checkpoint.roots().at("cube");
+
+        assert(l_expected.str() == l_resumed.str());
+
+    }
+
+    std::filesystem::remove(l_path);
+
+    /// The traversals which read stored children throw.
+    global_node_sink::bind(&l_chained_nodes);
+
+    l_thrown = false;
+
+    try { freeze({ l_functions[1][7] }); } catch (const std::logic_error&) { l_thrown = true; }
+
+    assert(l_thrown);
+
+    global_node_sink::bind(nullptr);
+
+}
+
 void unit_test_main(
 
 )
@@ -1300,11 +3767,36 @@ void unit_test_main(
     TEST(test_dag_logic_padding);
     TEST(test_dag_logic_invert);
     TEST(test_dag_logic_join);
+    TEST(test_dag_logic_apply);
+    TEST(test_logic_routing);
     TEST(test_demorgans);
     TEST(test_composite_function_logic);
     TEST(test_equivalent_functions);
     TEST(test_evaluate);
     TEST(test_node_istream_extractor);
+    TEST(test_zdd);
+    TEST(test_add);
+    TEST(test_bitvector);
+    TEST(test_dag_budget);
+    TEST(test_approximation);
+    TEST(test_predicates);
+    TEST(test_constrain);
+    TEST(test_permute);
+    TEST(test_join_breadth_first);
+    TEST(test_external);
+    TEST(test_compact);
+    TEST(test_dag_memory_resource);
+    TEST(test_frozen);
+    TEST(test_trace);
+    TEST(test_constraints);
+    TEST(test_netlist);
+    TEST(test_aig_lazy);
+    TEST(test_equivalence);
+    TEST(test_repl);
+    TEST(test_checkpoint);
+    TEST(test_codegen);
+    TEST(test_truth_table_leaves);
+    TEST(test_chain_nodes);
     
 }
 
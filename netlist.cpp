@@ -0,0 +1,468 @@
+#include <sstream>
+
+#include "include/netlist.h"
+
+namespace factor::aig
+{
+
+    ////////////////////////////////////////////
+    ////////////////// AIGER ///////////////////
+    ////////////////////////////////////////////
+    #pragma region AIGER
+
+    static constexpr edge UNDEFINED = UINT32_MAX;
+
+    /// Decodes one variable-length delta of the
+    ///     binary format, seven bits per byte.
+    static uint32_t read_delta(
+        std::istream& a_istream
+    )
+    {
+        uint32_t l_result = 0;
+
+        for (uint32_t l_shift = 0; l_shift < 32; l_shift += 7)
+        {
+            int l_byte = a_istream.get();
+
+            if (l_byte == EOF)
+                throw std::runtime_error("truncated aiger and section");
+
+            l_result |= uint32_t(l_byte & 0x7f) << l_shift;
+
+            if ((l_byte & 0x80) == 0)
+                return l_result;
+
+        }
+
+        throw std::runtime_error("malformed aiger delta");
+
+    }
+
+    netlist read_aiger(
+        std::istream& a_istream
+    )
+    {
+        std::string l_format;
+        uint32_t l_maximum = 0;
+        uint32_t l_input_count = 0;
+        uint32_t l_latch_count = 0;
+        uint32_t l_output_count = 0;
+        uint32_t l_and_count = 0;
+
+        a_istream >> l_format >> l_maximum >> l_input_count >> l_latch_count >> l_output_count >> l_and_count;
+
+        if (!a_istream || (l_format != "aag" && l_format != "aig"))
+            throw std::runtime_error("malformed aiger header");
+
+        if (l_latch_count != 0)
+            throw std::runtime_error("aiger latches are not supported");
+
+        bool l_binary = l_format == "aig";
+
+        /// Every input, latch and gate needs its own
+        ///     variable, and the binary format numbers
+        ///     them all consecutively.
+        uint64_t l_variable_count = uint64_t(l_input_count) + l_latch_count + l_and_count;
+
+        if (l_maximum < l_variable_count || (l_binary && l_maximum != l_variable_count) || l_maximum >= UINT32_MAX / 2)
+            throw std::runtime_error("malformed aiger header");
+
+        netlist l_result;
+
+        /// The edge of each aiger variable.
+        std::vector<edge> l_edges(l_maximum + 1, UNDEFINED);
+
+        l_edges[0] = ZERO_EDGE;
+
+        for (uint32_t i = 0; i < l_input_count; i++)
+        {
+            uint32_t l_variable = i + 1;
+
+            if (!l_binary)
+            {
+                uint32_t l_literal = 0;
+
+                if (!(a_istream >> l_literal) || (l_literal & 0x1) || (l_literal >> 1) > l_maximum)
+                    throw std::runtime_error("malformed aiger input");
+
+                l_variable = l_literal >> 1;
+
+            }
+
+            if (l_variable == 0 || l_variable > l_maximum || l_edges[l_variable] != UNDEFINED)
+                throw std::runtime_error("malformed aiger input");
+
+            l_edges[l_variable] = l_result.m_graph.input();
+            l_result.m_inputs.push_back(l_edges[l_variable]);
+
+        }
+
+        std::vector<uint32_t> l_output_literals(l_output_count);
+
+        for (uint32_t& l_literal : l_output_literals)
+            if (!(a_istream >> l_literal) || (l_literal >> 1) > l_maximum)
+                throw std::runtime_error("malformed aiger output");
+
+        const auto l_edge = [&](uint32_t a_literal)
+        {
+            if ((a_literal >> 1) > l_maximum || l_edges[a_literal >> 1] == UNDEFINED)
+                throw std::runtime_error("undefined aiger literal");
+
+            return l_edges[a_literal >> 1] ^ (a_literal & 0x1);
+
+        };
+
+        if (l_binary)
+        {
+            /// Skip the newline ending the last ASCII line.
+            a_istream.get();
+
+            /// Binary gates are defined in order, each
+            ///     after both of its fanins.
+            for (uint32_t i = 0; i < l_and_count; i++)
+            {
+                uint32_t l_lhs = 2 * (l_input_count + i + 1);
+                uint32_t l_delta0 = read_delta(a_istream);
+                uint32_t l_delta1 = read_delta(a_istream);
+
+                if ((l_lhs >> 1) > l_maximum || l_delta0 == 0 || l_delta0 > l_lhs || l_delta1 > l_lhs - l_delta0)
+                    throw std::runtime_error("malformed aiger and gate");
+
+                uint32_t l_rhs0 = l_lhs - l_delta0;
+                uint32_t l_rhs1 = l_rhs0 - l_delta1;
+
+                l_edges[l_lhs >> 1] = l_result.m_graph.conjoin(l_edge(l_rhs0), l_edge(l_rhs1));
+
+            }
+
+        }
+        else
+        {
+            /// ASCII gates may appear in any order, so
+            ///     they are defined in dependency order.
+            std::vector<std::pair<uint32_t, uint32_t>> l_definitions(l_maximum + 1, { UNDEFINED, UNDEFINED });
+
+            for (uint32_t i = 0; i < l_and_count; i++)
+            {
+                uint32_t l_lhs = 0;
+                uint32_t l_rhs0 = 0;
+                uint32_t l_rhs1 = 0;
+
+                if (!(a_istream >> l_lhs >> l_rhs0 >> l_rhs1) || (l_lhs & 0x1) || (l_lhs >> 1) > l_maximum)
+                    throw std::runtime_error("malformed aiger and gate");
+
+                /// Neither the constant nor an input, nor
+                ///     any gate, may be defined twice.
+                if (l_lhs == 0 || l_edges[l_lhs >> 1] != UNDEFINED || l_definitions[l_lhs >> 1].first != UNDEFINED)
+                    throw std::runtime_error("malformed aiger and gate");
+
+                l_definitions[l_lhs >> 1] = { l_rhs0, l_rhs1 };
+
+            }
+
+            std::vector<bool> l_pending(l_maximum + 1, false);
+
+            for (uint32_t l_root = 1; l_root <= l_maximum; l_root++)
+            {
+                std::stack<uint32_t> l_stack;
+
+                l_stack.push(l_root);
+
+                while (!l_stack.empty())
+                {
+                    uint32_t l_variable = l_stack.top();
+
+                    if (l_edges[l_variable] != UNDEFINED || l_definitions[l_variable].first == UNDEFINED)
+                    {
+                        l_stack.pop();
+                        continue;
+                    }
+
+                    auto [l_rhs0, l_rhs1] = l_definitions[l_variable];
+
+                    bool l_ready = true;
+
+                    for (uint32_t l_fanin : { l_rhs0 >> 1, l_rhs1 >> 1 })
+                        if (l_fanin > l_maximum)
+                            throw std::runtime_error("malformed aiger and gate");
+                        else if (l_edges[l_fanin] == UNDEFINED && l_definitions[l_fanin].first != UNDEFINED)
+                        {
+                            if (l_pending[l_fanin])
+                                throw std::runtime_error("cyclic aiger and gates");
+
+                            l_ready = false;
+                            l_stack.push(l_fanin);
+
+                        }
+
+                    if (!l_ready)
+                    {
+                        l_pending[l_variable] = true;
+                        continue;
+                    }
+
+                    l_edges[l_variable] = l_result.m_graph.conjoin(l_edge(l_rhs0), l_edge(l_rhs1));
+                    l_pending[l_variable] = false;
+
+                    l_stack.pop();
+
+                }
+
+            }
+
+        }
+
+        for (uint32_t l_literal : l_output_literals)
+            l_result.m_outputs.push_back(l_edge(l_literal));
+
+        for (uint32_t i = 0; i < l_input_count; i++)
+            l_result.m_input_names.push_back("i" + std::to_string(i));
+
+        for (uint32_t i = 0; i < l_output_count; i++)
+            l_result.m_output_names.push_back("o" + std::to_string(i));
+
+        /// The optional symbol table, up to a comment.
+        std::string l_line;
+
+        while (std::getline(a_istream, l_line))
+        {
+            if (l_line.empty())
+                continue;
+
+            if (l_line[0] == 'c')
+                break;
+
+            std::istringstream l_symbol(l_line.substr(1));
+
+            size_t l_position = 0;
+            std::string l_name;
+
+            if (!(l_symbol >> l_position) || !std::getline(l_symbol >> std::ws, l_name))
+                continue;
+
+            if (l_line[0] == 'i' && l_position < l_input_count)
+                l_result.m_input_names[l_position] = l_name;
+            else if (l_line[0] == 'o' && l_position < l_output_count)
+                l_result.m_output_names[l_position] = l_name;
+
+        }
+
+        return l_result;
+
+    }
+
+    #pragma endregion
+
+    ////////////////////////////////////////////
+    /////////////////// BLIF ///////////////////
+    ////////////////////////////////////////////
+    #pragma region BLIF
+
+    /// A single-output cover of a .names block, as its
+    ///     input signals and its rows of input pattern
+    ///     and output value.
+    struct cover
+    {
+        std::vector<std::string> m_inputs;
+        std::vector<std::pair<std::string, char>> m_rows;
+    };
+
+    netlist read_blif(
+        std::istream& a_istream
+    )
+    {
+        netlist l_result;
+
+        std::map<std::string, edge> l_signals;
+        std::map<std::string, cover> l_covers;
+
+        cover* l_current = nullptr;
+
+        std::string l_line;
+        std::string l_logical_line;
+
+        bool l_ended = false;
+
+        while (!l_ended && std::getline(a_istream, l_line))
+        {
+            l_line = l_line.substr(0, l_line.find('#'));
+
+            /// Join continued lines.
+            if (!l_line.empty() && l_line.back() == '\\')
+            {
+                l_logical_line += l_line.substr(0, l_line.size() - 1) + " ";
+                continue;
+            }
+
+            l_logical_line += l_line;
+
+            std::istringstream l_tokens(l_logical_line);
+
+            l_logical_line.clear();
+
+            std::vector<std::string> l_words;
+
+            for (std::string l_word; l_tokens >> l_word;)
+                l_words.push_back(l_word);
+
+            if (l_words.empty())
+                continue;
+
+            if (l_words[0][0] != '.')
+            {
+                if (l_current == nullptr)
+                    throw std::runtime_error("blif cover row outside of .names");
+
+                if (l_current->m_inputs.empty() && l_words.size() == 1 && l_words[0].size() == 1)
+                    l_current->m_rows.emplace_back("", l_words[0][0]);
+                else if (l_words.size() == 2 && l_words[0].size() == l_current->m_inputs.size() && l_words[1].size() == 1)
+                    l_current->m_rows.emplace_back(l_words[0], l_words[1][0]);
+                else
+                    throw std::runtime_error("malformed blif cover row");
+
+                continue;
+
+            }
+
+            l_current = nullptr;
+
+            if (l_words[0] == ".model")
+                continue;
+
+            if (l_words[0] == ".inputs")
+            {
+                for (size_t i = 1; i < l_words.size(); i++)
+                {
+                    edge l_input = l_result.m_graph.input();
+
+                    l_signals[l_words[i]] = l_input;
+                    l_result.m_inputs.push_back(l_input);
+                    l_result.m_input_names.push_back(l_words[i]);
+
+                }
+            }
+            else if (l_words[0] == ".outputs")
+            {
+                l_result.m_output_names.insert(l_result.m_output_names.end(), l_words.begin() + 1, l_words.end());
+            }
+            else if (l_words[0] == ".names")
+            {
+                if (l_words.size() < 2 || l_covers.contains(l_words.back()) || l_signals.contains(l_words.back()))
+                    throw std::runtime_error("malformed blif .names");
+
+                l_current = &l_covers[l_words.back()];
+                l_current->m_inputs.assign(l_words.begin() + 1, l_words.end() - 1);
+
+            }
+            else if (l_words[0] == ".end")
+            {
+                l_ended = true;
+            }
+            else
+            {
+                throw std::runtime_error("unsupported blif construct " + l_words[0]);
+            }
+
+        }
+
+        /// Builds the signal's cover once all of its
+        ///     inputs are built, in dependency order.
+        const auto l_build = [&](const std::string& a_signal)
+        {
+            std::stack<std::string> l_stack;
+            std::set<std::string> l_pending;
+
+            l_stack.push(a_signal);
+
+            while (!l_stack.empty())
+            {
+                std::string l_signal = l_stack.top();
+
+                if (l_signals.contains(l_signal))
+                {
+                    l_stack.pop();
+                    continue;
+                }
+
+                auto l_cover = l_covers.find(l_signal);
+
+                if (l_cover == l_covers.end())
+                    throw std::runtime_error("undefined blif signal " + l_signal);
+
+                bool l_ready = true;
+
+                for (const std::string& l_input : l_cover->second.m_inputs)
+                    if (!l_signals.contains(l_input))
+                    {
+                        if (l_pending.contains(l_input))
+                            throw std::runtime_error("cyclic blif signal " + l_input);
+
+                        l_ready = false;
+                        l_stack.push(l_input);
+
+                    }
+
+                if (!l_ready)
+                {
+                    l_pending.insert(l_signal);
+                    continue;
+                }
+
+                const std::vector<std::pair<std::string, char>>& l_rows = l_cover->second.m_rows;
+
+                /// The rows list either the on-set or the
+                ///     off-set, as given by their output.
+                edge l_sum = ZERO_EDGE;
+
+                for (const auto& [l_pattern, l_output] : l_rows)
+                {
+                    if (l_output != l_rows[0].second || (l_output != '0' && l_output != '1'))
+                        throw std::runtime_error("malformed blif cover of " + l_signal);
+
+                    edge l_cube = ONE_EDGE;
+
+                    for (size_t j = 0; j < l_pattern.size(); j++)
+                    {
+                        if (l_pattern[j] == '-')
+                            continue;
+
+                        if (l_pattern[j] != '0' && l_pattern[j] != '1')
+                            throw std::runtime_error("malformed blif cover of " + l_signal);
+
+                        edge l_literal = l_signals[l_cover->second.m_inputs[j]];
+
+                        if (l_pattern[j] == '0')
+                            l_literal = invert(l_literal);
+
+                        l_cube = l_cube == ONE_EDGE ? l_literal : l_result.m_graph.conjoin(l_cube, l_literal);
+
+                    }
+
+                    l_sum = l_sum == ZERO_EDGE ? l_cube : l_result.m_graph.disjoin(l_sum, l_cube);
+
+                }
+
+                if (!l_rows.empty() && l_rows[0].second == '0')
+                    l_sum = invert(l_sum);
+
+                l_signals[l_signal] = l_sum;
+                l_pending.erase(l_signal);
+
+                l_stack.pop();
+
+            }
+
+            return l_signals[a_signal];
+
+        };
+
+        for (const std::string& l_output : l_result.m_output_names)
+            l_result.m_outputs.push_back(l_build(l_output));
+
+        return l_result;
+
+    }
+
+    #pragma endregion
+
+}
@@ -0,0 +1,357 @@
+#include <sstream>
+
+#include "include/repl.h"
+
+namespace factor
+{
+
+    static const std::map<std::string, operation> s_binary_operations =
+    {
+        { "conjoin", operation::AND },
+        { "disjoin", operation::OR },
+        { "exor", operation::XOR },
+        { "exnor", operation::XNOR },
+    };
+
+    static const std::set<std::string> s_named_commands =
+    {
+        "define", "parse", "invert", "print", "evaluate", "count", "any_sat", "drop",
+    };
+
+    /// Writes the terminals, which operator<<
+    ///     leaves empty, as 0 and 1.
+    static void print(
+        std::ostream& a_ostream,
+        const node* a_node
+    )
+    {
+        if (a_node == ZERO)
+            a_ostream << "0";
+        else if (a_node == ONE)
+            a_ostream << "1";
+        else
+            a_ostream << a_node;
+    }
+
+    /// Checks the expression against the grammar
+    ///     operator>> reads, which trusts its input:
+    ///     bracketed variables, each optionally
+    ///     followed by an apostrophe, balanced parens,
+    ///     and sums.
+    static bool well_formed(
+        const std::string& a_expression
+    )
+    {
+        size_t l_depth = 0;
+        bool l_invertible = false;
+
+        for (size_t i = 0; i < a_expression.size(); i++)
+        {
+            char l_char = a_expression[i];
+
+            if (l_char == '[')
+            {
+                size_t l_end = a_expression.find(']', i);
+
+                if (l_end == std::string::npos || l_end == i + 1 || l_end - i > 11)
+                    return false;
+
+                uint64_t l_variable = 0;
+
+                for (size_t j = i + 1; j < l_end; j++)
+                {
+                    if (a_expression[j] < '0' || a_expression[j] > '9')
+                        return false;
+
+                    l_variable = 10 * l_variable + (a_expression[j] - '0');
+
+                }
+
+                if (l_variable >= node::LEAF_FLAG)
+                    return false;
+
+                i = l_end;
+                l_invertible = true;
+
+                continue;
+
+            }
+
+            if (l_char == '\'' && !l_invertible)
+                return false;
+
+            if (l_char == ')' && l_depth-- == 0)
+                return false;
+
+            if (l_char == '(')
+                l_depth++;
+
+            if (l_char != '(' && l_char != ')' && l_char != '+' && l_char != '\'' && l_char != ' ')
+                return false;
+
+            l_invertible = l_char == ')';
+
+        }
+
+        return l_depth == 0;
+
+    }
+
+    const node* repl::lookup(
+        const std::string& a_name
+    ) const
+    {
+        auto l_it = m_names.find(a_name);
+
+        if (l_it == m_names.end())
+            throw std::runtime_error("undefined name " + a_name);
+
+        return l_it->second;
+
+    }
+
+    bool repl::execute(
+        const std::string& a_line,
+        std::ostream& a_ostream
+    )
+    {
+        std::stringstream l_line(a_line);
+
+        std::string l_command;
+        std::string l_name;
+
+        if (!(l_line >> l_command))
+            return true;
+
+        m_commands++;
+
+        if (l_command == "quit")
+        {
+            a_ostream << "ok" << std::endl;
+            return false;
+        }
+
+        dag* l_previous = global_node_sink::bound();
+
+        global_node_sink::bind(&m_nodes);
+
+        try
+        {
+            std::stringstream l_result;
+
+            if (l_command != "stats" &&
+                !s_named_commands.contains(l_command) &&
+                !s_binary_operations.contains(l_command))
+            {
+                throw std::runtime_error("unknown command " + l_command);
+            }
+            else if (l_command == "stats")
+            {
+                l_result
+                    << "nodes " << m_nodes.size()
+                    << " names " << m_names.size()
+                    << " cached " << m_operations.m_applications.size() + m_fractions.size()
+                    << " commands " << m_commands;
+            }
+            else if (!(l_line >> l_name))
+            {
+                throw std::runtime_error("missing name");
+            }
+            else if (l_command == "define")
+            {
+                uint32_t l_variable;
+
+                if (!(l_line >> l_variable))
+                    throw std::runtime_error("missing variable");
+
+                if (l_variable >= node::LEAF_FLAG)
+                    throw std::runtime_error("variable out of range");
+
+                m_names[l_name] = literal(l_variable, l_line.peek() != '\'');
+
+            }
+            else if (l_command == "parse")
+            {
+                std::string l_expression;
+
+                std::getline(l_line >> std::ws, l_expression);
+
+                if (!well_formed(l_expression))
+                    throw std::runtime_error("malformed expression");
+
+                std::stringstream l_stream(l_expression);
+
+                const node* l_node;
+
+                l_stream >> l_node;
+
+                m_names[l_name] = l_node;
+
+            }
+            else if (s_binary_operations.contains(l_command))
+            {
+                std::string l_x;
+                std::string l_y;
+
+                if (!(l_line >> l_x >> l_y))
+                    throw std::runtime_error("missing operand");
+
+                m_names[l_name] = apply(
+                    m_operations.m_applications,
+                    s_binary_operations.at(l_command),
+                    lookup(l_x),
+                    lookup(l_y)
+                );
+
+            }
+            else if (l_command == "invert")
+            {
+                std::string l_x;
+
+                if (!(l_line >> l_x))
+                    throw std::runtime_error("missing operand");
+
+                m_names[l_name] = m_operations.invert(lookup(l_x));
+
+            }
+            else if (l_command == "print")
+            {
+                print(l_result, lookup(l_name));
+            }
+            else if (l_command == "evaluate")
+            {
+                std::string l_bits;
+
+                l_line >> l_bits;
+
+                std::vector<bool> l_input;
+
+                for (char l_bit : l_bits)
+                {
+                    if (l_bit != '0' && l_bit != '1')
+                        throw std::runtime_error("malformed bits");
+
+                    l_input.push_back(l_bit == '1');
+
+                }
+
+                const node* l_node = lookup(l_name);
+
+                /// Unlisted variables are false.
+                for (uint32_t l_variable : support(l_node))
+                    if (l_input.size() <= l_variable)
+                        l_input.resize(l_variable + 1, false);
+
+                l_result << (evaluate(l_node, l_input) ? 1 : 0);
+
+            }
+            else if (l_command == "count")
+            {
+                int64_t l_variable_count;
+
+                if (!(l_line >> l_variable_count))
+                    throw std::runtime_error("missing variable count");
+
+                const node* l_node = lookup(l_name);
+
+                std::set<uint32_t> l_support = support(l_node);
+
+                /// The count must cover the support, and
+                ///     fit the range of a double.
+                if (l_variable_count < (l_support.empty() ? 0 : int64_t(*l_support.rbegin()) + 1) ||
+                    l_variable_count > 1023)
+                    throw std::runtime_error("variable count out of range");
+
+                l_result << std::ldexp(fraction(m_fractions, l_node), (int)l_variable_count);
+
+            }
+            else if (l_command == "any_sat")
+            {
+                const node* l_node = lookup(l_name);
+
+                if (l_node == ZERO)
+                {
+                    l_result << "none";
+                }
+                else
+                {
+                    std::string l_bits;
+
+                    /// Every node other than ZERO is
+                    ///     satisfiable, so descend into
+                    ///     any child which is not ZERO.
+                    while (l_node != ONE)
+                    {
+                        /// A leaf is satisfied by any row
+                        ///     its table sets.
+                        if (l_node->is_leaf())
+                        {
+                            int l_row = std::countr_zero(l_node->table());
+
+                            if (l_bits.size() < l_node->leaf_depth() + l_node->leaf_width())
+                                l_bits.resize(l_node->leaf_depth() + l_node->leaf_width(), '0');
+
+                            for (uint32_t i = 0; i < l_node->leaf_width(); i++)
+                                l_bits[l_node->leaf_depth() + i] = ((l_row >> i) & 0x1) != 0 ? '1' : '0';
+
+                            break;
+
+                        }
+
+                        const node* l_negative = m_nodes.negative(l_node);
+
+                        bool l_positive = l_negative == ZERO;
+
+                        if (l_bits.size() <= l_node->depth())
+                            l_bits.resize(l_node->depth() + 1, '0');
+
+                        l_bits[l_node->depth()] = l_positive ? '1' : '0';
+
+                        l_node = l_positive ? m_nodes.positive(l_node) : l_negative;
+
+                    }
+
+                    l_result << l_bits;
+
+                }
+
+            }
+            else if (l_command == "drop")
+            {
+                if (m_names.erase(l_name) == 0)
+                    throw std::runtime_error("undefined name " + l_name);
+            }
+
+            a_ostream << "ok";
+
+            if (!l_result.str().empty())
+                a_ostream << " " << l_result.str();
+
+            a_ostream << std::endl;
+
+        }
+        catch (const std::exception& l_exception)
+        {
+            a_ostream << "error " << l_exception.what() << std::endl;
+        }
+
+        global_node_sink::bind(l_previous);
+
+        return true;
+
+    }
+
+    void repl::run(
+        std::istream& a_istream,
+        std::ostream& a_ostream
+    )
+    {
+        std::string l_line;
+
+        while (std::getline(a_istream, l_line))
+            if (!execute(l_line, a_ostream))
+                return;
+
+    }
+
+}
@@ -0,0 +1,172 @@
+#include <iostream>
+#include <sstream>
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+
+#include "include/repl.h"
+
+/// Serves one repl, reading commands from stdin, or,
+///     given --socket PATH, from the connections to a
+///     Unix socket, one at a time. The dag and its
+///     caches persist across every connection.
+///
+///     factor-dag [--socket PATH]
+
+/// Serves one connection until it closes or quits.
+///     Returns false once asked to quit.
+static bool serve(
+    factor::repl& a_repl,
+    int a_connection
+)
+{
+    std::string l_pending;
+    char l_buffer[4096];
+
+    while (true)
+    {
+        ssize_t l_received = recv(a_connection, l_buffer, sizeof(l_buffer), 0);
+
+        if (l_received <= 0)
+            return true;
+
+        l_pending.append(l_buffer, l_received);
+
+        size_t l_end;
+
+        while ((l_end = l_pending.find('\n')) != std::string::npos)
+        {
+            std::stringstream l_response;
+
+            bool l_continue = a_repl.execute(l_pending.substr(0, l_end), l_response);
+
+            l_pending.erase(0, l_end + 1);
+
+            std::string l_text = l_response.str();
+
+            for (size_t l_sent = 0; l_sent < l_text.size();)
+            {
+                ssize_t l_count = send(a_connection, l_text.data() + l_sent, l_text.size() - l_sent, MSG_NOSIGNAL);
+
+                if (l_count <= 0)
+                    return true;
+
+                l_sent += l_count;
+
+            }
+
+            if (!l_continue)
+                return false;
+
+        }
+
+    }
+
+}
+
+int main(
+    int argc,
+    char** argv
+)
+{
+    factor::repl l_repl;
+
+    if (argc == 1)
+    {
+        l_repl.run(std::cin, std::cout);
+        return 0;
+    }
+
+    if (argc != 3 || std::string(argv[1]) != "--socket")
+    {
+        std::cerr << "usage: " << argv[0] << " [--socket PATH]" << std::endl;
+        return 1;
+    }
+
+    sockaddr_un l_address = {};
+    l_address.sun_family = AF_UNIX;
+
+    if (std::strlen(argv[2]) >= sizeof(l_address.sun_path))
+    {
+        std::cerr << "socket path too long" << std::endl;
+        return 1;
+    }
+
+    std::strcpy(l_address.sun_path, argv[2]);
+
+    /// A stale socket left by an earlier server is
+    ///     replaced, but nothing else at the path is.
+    struct stat l_status;
+
+    if (lstat(argv[2], &l_status) == 0)
+    {
+        if (!S_ISSOCK(l_status.st_mode))
+        {
+            std::cerr << "refusing to replace " << argv[2] << ": not a socket" << std::endl;
+            return 1;
+        }
+
+        unlink(argv[2]);
+
+    }
+
+    int l_socket = socket(AF_UNIX, SOCK_STREAM, 0);
+
+    if (l_socket < 0 ||
+        bind(l_socket, (sockaddr*)&l_address, sizeof(l_address)) != 0 ||
+        listen(l_socket, 16) != 0)
+    {
+        std::cerr << "cannot listen on " << argv[2] << ": " << std::strerror(errno) << std::endl;
+        return 1;
+    }
+
+    bool l_serving = true;
+    int l_status_code = 0;
+
+    /// The delay before retrying an accept which
+    ///     failed for want of resources.
+    useconds_t l_backoff = 0;
+
+    while (l_serving)
+    {
+        int l_connection = accept(l_socket, nullptr, nullptr);
+
+        if (l_connection < 0)
+        {
+            /// Interrupted, or aborted by the client.
+            if (errno == EINTR || errno == ECONNABORTED)
+                continue;
+
+            /// Out of descriptors or memory, which
+            ///     closing connections may relieve.
+            if (errno == EMFILE || errno == ENFILE || errno == ENOBUFS || errno == ENOMEM)
+            {
+                l_backoff = std::min<useconds_t>(l_backoff == 0 ? 10000 : 2 * l_backoff, 1000000);
+                usleep(l_backoff);
+                continue;
+            }
+
+            /// Any other failure recurs on every call.
+            std::cerr << "cannot accept on " << argv[2] << ": " << std::strerror(errno) << std::endl;
+            l_status_code = 1;
+            break;
+
+        }
+
+        l_backoff = 0;
+
+        l_serving = serve(l_repl, l_connection);
+
+        close(l_connection);
+
+    }
+
+    close(l_socket);
+    unlink(argv[2]);
+
+    return l_status_code;
+
+}